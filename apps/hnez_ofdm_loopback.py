@@ -0,0 +1,316 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+'''
+Sends packets through ho_ofdm_tx, a simulated channel
+(multipath, carrier frequency offset and AWGN),
+ho_schmidl_cox_gate and ho_ofdm_rx as fast as possible
+and reports the throughput, the time spent in every block,
+the detection rate and the frame and bit error rates.
+'''
+
+from __future__ import print_function
+
+import os
+
+# Has to be set before gnuradio reads its preferences
+os.environ.setdefault('GR_CONF_PERFCOUNTERS_ON', 'True')
+
+import argparse
+import json
+import random
+import struct
+import time
+
+from gnuradio import gr, blocks, channels
+import pmt
+
+import hnez_ofdm
+
+
+class loopback(gr.top_block):
+    def __init__(self, args):
+        gr.top_block.__init__(self, 'hnez_ofdm loopback')
+
+        sym_len= args.fft_len + args.cp_len
+
+        # Every packet starts with its sequence number so that
+        # received packets can be compared to the sent ones
+        rng= random.Random(args.seed)
+
+        self.packets= list()
+        data= list()
+        tags= list()
+
+        for seq in range(args.num_packets):
+            packet= struct.pack('>I', seq)
+            packet+= bytes(bytearray(rng.randrange(256)
+                                     for i in range(args.packet_len - 4)))
+            packet= bytearray(packet)
+
+            tag= gr.tag_t()
+            tag.offset= len(data)
+            tag.key= pmt.intern('packet_len')
+            tag.value= pmt.from_long(len(packet))
+
+            tags.append(tag)
+            data.extend(packet)
+            self.packets.append(packet)
+
+        self.src= blocks.vector_source_b(data, False, 1, tags)
+
+        self.tx= hnez_ofdm.ho_ofdm_tx(args.fft_len, args.cp_len,
+                                      args.num_carriers)
+
+        # All packets have the same length and thus the same number
+        # of symbols. Insert some symbols of silence after every frame,
+        # the gate only stops once the receiver acknowledged the frame.
+        (self.frame_symbols, self.frame_power)= frame_stats(args)
+
+        self.silence= blocks.null_source(gr.sizeof_gr_complex * sym_len)
+        self.mux= blocks.stream_mux(gr.sizeof_gr_complex * sym_len,
+                                    (self.frame_symbols, args.gap_symbols))
+        self.v2s= blocks.vector_to_stream(gr.sizeof_gr_complex, sym_len)
+
+        # The transmitter does not scale its output and the unused
+        # carriers are filled too, bring the frames to unit power
+        # per sample so that the noise voltage matches the SNR
+        self.scale= blocks.multiply_const_cc(self.frame_power ** -0.5)
+
+        self.channel= channels.channel_model(
+            noise_voltage=10 ** (-args.snr / 20.0),
+            frequency_offset=args.cfo / args.fft_len,
+            epsilon=1.0,
+            taps=args.taps,
+            noise_seed=args.seed,
+            block_tags=False
+        )
+
+        self.gate= hnez_ofdm.ho_schmidl_cox_gate(args.fft_len, args.cp_len,
+                                                 args.rel_pw_lo, args.rel_pw_hi,
+                                                 True, args.threads,
+                                                 False, True, 0,
+                                                 args.fine_timing,
+                                                 args.max_cfo)
+        # The raw PDUs are published before the CRC check,
+        # the bit error rate is measured on them
+        self.rx= hnez_ofdm.ho_ofdm_rx(args.fft_len, args.num_carriers,
+                                      False, [],
+                                      max(args.packet_len, 4096),
+                                      True)
+
+        self.detections= blocks.tag_debug(gr.sizeof_gr_complex * args.fft_len,
+                                          'gate', 'frame_id')
+        self.detections.set_display(False)
+
+        self.pdus= blocks.message_debug()
+        self.raw_pdus= blocks.message_debug()
+        self.acks= blocks.message_debug()
+
+        self.connect(self.src, self.tx, (self.mux, 0))
+        self.connect(self.silence, (self.mux, 1))
+        self.connect(self.mux, self.v2s, self.scale, self.channel, self.gate)
+        self.connect(self.gate, self.rx)
+        self.connect(self.gate, self.detections)
+
+        self.msg_connect(self.rx, 'frame_ack', self.gate, 'frame_ack')
+        self.msg_connect(self.rx, 'pdus', self.pdus, 'store')
+        self.msg_connect(self.rx, 'raw_pdus', self.raw_pdus, 'store')
+        self.msg_connect(self.rx, 'frame_ack', self.acks, 'store')
+
+    def named_blocks(self):
+        return (
+            ('ho_ofdm_tx', self.tx),
+            ('channel_model', self.channel),
+            ('ho_schmidl_cox_gate', self.gate),
+            ('ho_ofdm_rx', self.rx),
+        )
+
+
+def frame_stats(args):
+    '''Run a single packet through the transmitter to find out
+    how many symbols a frame is long and its power per sample'''
+
+    tb= gr.top_block()
+
+    tag= gr.tag_t()
+    tag.offset= 0
+    tag.key= pmt.intern('packet_len')
+    tag.value= pmt.from_long(args.packet_len)
+
+    src= blocks.vector_source_b([0] * args.packet_len, False, 1, [tag])
+    tx= hnez_ofdm.ho_ofdm_tx(args.fft_len, args.cp_len, args.num_carriers)
+    dst= blocks.vector_sink_c(args.fft_len + args.cp_len)
+
+    tb.connect(src, tx, dst)
+    tb.run()
+
+    samples= dst.data()
+    power= sum(abs(s) ** 2 for s in samples) / len(samples)
+
+    return (len(samples) // (args.fft_len + args.cp_len), power)
+
+
+def block_times(tb):
+    '''Time spent in the work functions, needs a GNU Radio
+    built with performance counters'''
+
+    try:
+        ticks_per_s= float(gr.high_res_timer_tps())
+
+        return dict(
+            (name, blk.pc_work_time_total() / ticks_per_s)
+            for (name, blk) in tb.named_blocks()
+        )
+
+    except (AttributeError, RuntimeError):
+        return None
+
+
+def received_payloads(msgs, num_sent):
+    '''The payloads of the PDUs in a message_debug block,
+    keyed by the sequence number they start with'''
+
+    received= dict()
+    last_seq= -1
+
+    for idx in range(msgs.num_messages()):
+        pdu= msgs.get_message(idx)
+        payload= bytearray(pmt.u8vector_elements(pmt.cdr(pdu)))
+        seq= num_sent
+
+        if len(payload) >= 4:
+            (seq, )= struct.unpack('>I', bytes(payload[:4]))
+
+        # The sequence number of a corrupted frame may be
+        # wrong too, assume that it followed the last one
+        if (seq >= num_sent) or (seq in received):
+            seq= last_seq + 1
+
+        if seq < num_sent:
+            received[seq]= payload
+            last_seq= seq
+
+    return received
+
+
+def evaluate(tb, args, seconds):
+    num_sent= len(tb.packets)
+
+    received= received_payloads(tb.pdus, num_sent)
+
+    # The bit errors are counted before the CRC check,
+    # over all frames whose header could be decoded
+    decoded= received_payloads(tb.raw_pdus, num_sent)
+    bit_errors= 0
+
+    for (seq, payload) in decoded.items():
+        sent= tb.packets[seq]
+
+        if len(payload) != len(sent):
+            bit_errors+= 8 * len(sent)
+            continue
+
+        for (a, b) in zip(payload, sent):
+            bit_errors+= bin(a ^ b).count('1')
+
+    num_received= len(received)
+    num_decoded= len(decoded)
+    num_bits= 8 * args.packet_len * max(num_decoded, 1)
+
+    return {
+        'params': {
+            'fft_len': args.fft_len,
+            'cp_len': args.cp_len,
+            'num_carriers': args.num_carriers,
+            'packet_len': args.packet_len,
+            'frame_symbols': tb.frame_symbols,
+            'frame_power': tb.frame_power,
+            'snr_db': args.snr,
+            'cfo_carriers': args.cfo,
+            'taps': [[t.real, t.imag] for t in args.taps],
+            'threads': args.threads,
+            'fine_timing': args.fine_timing,
+            'max_cfo_carriers': args.max_cfo,
+        },
+        'seconds': seconds,
+        'frames_sent': num_sent,
+        'frames_detected': tb.detections.num_tags(),
+        'frames_acked': tb.acks.num_messages(),
+        'frames_decoded': num_decoded,
+        'frames_received': num_received,
+        'frames_per_s': num_received / seconds,
+        'payload_bytes_per_s': num_received * args.packet_len / seconds,
+        'detection_rate': float(tb.detections.num_tags()) / num_sent,
+        'fer': 1.0 - float(num_received) / num_sent,
+        'ber': float(bit_errors) / num_bits,
+        'block_seconds': block_times(tb),
+    }
+
+
+def parse_taps(text):
+    return [complex(t) for t in text.split(',')]
+
+
+def main():
+    parser= argparse.ArgumentParser(description=__doc__)
+
+    parser.add_argument('--fft-len', type=int, default=128)
+    parser.add_argument('--cp-len', type=int, default=16)
+    parser.add_argument('--num-carriers', type=int, default=96)
+    parser.add_argument('--packet-len', type=int, default=500,
+                        help='bytes per packet, at least 4')
+    parser.add_argument('--num-packets', type=int, default=1000)
+    parser.add_argument('--gap-symbols', type=int, default=8,
+                        help='symbols of silence between frames')
+    parser.add_argument('--snr', type=float, default=20,
+                        help='signal to noise ratio in dB')
+    parser.add_argument('--cfo', type=float, default=0.1,
+                        help='carrier frequency offset in carrier spacings')
+    parser.add_argument('--taps', type=parse_taps, default=[1],
+                        help='comma separated multipath taps, e.g. 1,0.3j')
+    parser.add_argument('--rel-pw-lo', type=float, default=0.7)
+    parser.add_argument('--rel-pw-hi', type=float, default=0.8)
+    parser.add_argument('--threads', type=int, default=1,
+                        help='threads of the gate')
+    parser.add_argument('--fine-timing', action='store_true',
+                        help='refine the frame start in the gate')
+    parser.add_argument('--max-cfo', type=int, default=0,
+                        help='largest CFO in carrier spacings the gate '
+                        'should resolve, 0 for at most one')
+    parser.add_argument('--seed', type=int, default=1)
+
+    args= parser.parse_args()
+
+    if args.packet_len < 4:
+        parser.error('--packet-len has to be at least 4')
+
+    tb= loopback(args)
+
+    start= time.time()
+    tb.run()
+    seconds= time.time() - start
+
+    print(json.dumps(evaluate(tb, args, seconds), indent=2, sort_keys=True))
+
+
+if __name__ == '__main__':
+    main()
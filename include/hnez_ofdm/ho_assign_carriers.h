@@ -29,9 +29,22 @@ namespace gr {
   namespace hnez_ofdm {
 
     /*!
-     * \brief <+description of block+>
+     * \brief Place vectors of num_carriers data symbols on fft_len FFT bins
      * \ingroup hnez_ofdm
      *
+     * The output is in fft shifted order, DC is at bin fft_len/2.
+     * By default the data carriers are spread over the whole
+     * spectrum and the remaining bins are set to one.
+     *
+     * With contiguous set the data carriers occupy the bins
+     * closest to DC, leaving DC and the band edges free.
+     * Every bin that carries neither data nor a pilot is set to fill,
+     * use a fill of zero to null the DC and guard carriers.
+     * pilot_symbols[i] is sent on bin pilot_carriers[i] in every symbol.
+     *
+     * With add_preamble set the two preamble symbols of
+     * ho_add_schmidlcox are put in front of every packet,
+     * replacing a separate ho_add_schmidlcox block.
      */
     class HNEZ_OFDM_API ho_assign_carriers : virtual public gr::tagged_stream_block
     {
@@ -46,7 +59,11 @@ namespace gr {
        * class. hnez_ofdm::ho_assign_carriers::make is the public interface for
        * creating new instances.
        */
-      static sptr make(int num_carriers, int fft_len, const std::string& len_tag_key="packet_len");
+      static sptr make(int num_carriers, int fft_len, const std::string& len_tag_key="packet_len",
+                       bool contiguous=false, const gr_complex &fill=gr_complex(1, 0),
+                       const std::vector<int> &pilot_carriers=std::vector<int>(),
+                       const std::vector<gr_complex> &pilot_symbols=std::vector<gr_complex>(),
+                       bool add_preamble=false);
     };
 
   } // namespace hnez_ofdm
@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_EXTRACT_CARRIERS_H
+#define INCLUDED_HNEZ_OFDM_HO_EXTRACT_CARRIERS_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief Equalize received OFDM symbols and extract the data carriers
+     * \ingroup hnez_ofdm
+     *
+     * The receive side counterpart of ho_assign_carriers.
+     * Takes fft shifted frequency domain symbols of fft_len bins,
+     * like the ones output by ho_schmidl_cox_gate with fft_out set,
+     * and outputs the num_carriers data carriers of every payload symbol.
+     *
+     * A frame starts at a symbol tagged with frame_id.
+     * This first preamble symbol is dropped, the second one is
+     * compared to the preamble_b sent by ho_add_schmidlcox
+     * to estimate the channel of every data carrier.
+     * The following symbols are equalized using this estimate.
+     * Symbols outside of a frame are dropped.
+     *
+     * The tags of the first preamble symbol are moved
+     * to the first payload symbol.
+     * num_carriers, fft_len, contiguous and pilot_carriers
+     * have to match the settings of ho_assign_carriers.
+     */
+    class HNEZ_OFDM_API ho_extract_carriers : virtual public gr::block
+    {
+     public:
+      typedef boost::shared_ptr<ho_extract_carriers> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_extract_carriers.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_extract_carriers's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_extract_carriers::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int num_carriers, int fft_len, bool contiguous=false,
+                       const std::vector<int> &pilot_carriers=std::vector<int>());
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_EXTRACT_CARRIERS_H */
@@ -0,0 +1,65 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_HAMMING74_SOFT_H
+#define INCLUDED_HNEZ_OFDM_HO_HAMMING74_SOFT_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief Soft decision Hamming(7,4) decoder
+     * \ingroup hnez_ofdm
+     *
+     * Takes one log-likelihood ratio per coded bit,
+     * log(P(bit=0)/P(bit=1)), so positive values mean
+     * the bit is more likely a zero.
+     * Bit k of the input stream corresponds to bit k%8 of
+     * byte k/8 of the packed stream produced by
+     * ho_hamming74_packed when encoding (LSB first).
+     *
+     * Every group of seven LLRs is decoded to the codeword
+     * with the maximum correlation (maximum likelihood).
+     * The output is packed like the output of
+     * ho_hamming74_packed when decoding.
+     */
+    class HNEZ_OFDM_API ho_hamming74_soft : virtual public gr::tagged_stream_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_hamming74_soft> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_hamming74_soft.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_hamming74_soft's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_hamming74_soft::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(const std::string& len_tag_key="packet_len");
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_HAMMING74_SOFT_H */
@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_IFFT_CYCLICPREFIX_H
+#define INCLUDED_HNEZ_OFDM_HO_IFFT_CYCLICPREFIX_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief Inverse FFT and cyclic prefix insertion in one block
+     * \ingroup hnez_ofdm
+     *
+     * Does the same as an inverse FFT block followed by
+     * ho_add_cyclicprefix, without the intermediate buffer.
+     * The output is not scaled.
+     * With fft_shift set, DC is expected in the center of the
+     * input vectors, like the output of ho_assign_carriers.
+     *
+     * window_len (at most cp_len) samples at the start of every
+     * cyclic prefix are shaped with a raised cosine and
+     * overlapped with the end of the previous symbol,
+     * reducing the out of band emissions.
+     */
+    class HNEZ_OFDM_API ho_ifft_cyclicprefix : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_ifft_cyclicprefix> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_ifft_cyclicprefix.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_ifft_cyclicprefix's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_ifft_cyclicprefix::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int fft_len, int cp_len, bool fft_shift=true, int window_len=0);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_IFFT_CYCLICPREFIX_H */
@@ -0,0 +1,78 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_OFDM_RX_H
+#define INCLUDED_HNEZ_OFDM_HO_OFDM_RX_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief The receiver for frames sent by ho_ofdm_tx
+     * \ingroup hnez_ofdm
+     *
+     * Takes the time domain symbols output by ho_schmidl_cox_gate
+     * (with fft_out unset) and does the FFT, equalization,
+     * QPSK demapping, deinterleaving, Hamming decoding and
+     * ho_add_header parsing. Packets with a valid CRC are
+     * published as PDUs on the pdus port, the metadata
+     * contains the tags of the frame start (frame_id, ...).
+     *
+     * As soon as the header of a frame is decoded the pair
+     * (frame_id . number of symbols in the frame) is sent on
+     * the frame_ack port. Connect it to the frame_ack port
+     * of the gate to stop it at the end of the frame.
+     * Frames announcing more than max_payload_len bytes are dropped.
+     *
+     * With raw_pdus set every decoded payload is also published
+     * on the raw_pdus port, before and independent of the CRC check.
+     * The metadata then has an additional crc_ok entry.
+     * This is meant for measuring bit error rates.
+     *
+     * num_carriers, contiguous and pilot_carriers have to
+     * match the settings of the transmitter.
+     */
+    class HNEZ_OFDM_API ho_ofdm_rx : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_ofdm_rx> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_ofdm_rx.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_ofdm_rx's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_ofdm_rx::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int fft_len, int num_carriers,
+                       bool contiguous=false,
+                       const std::vector<int> &pilot_carriers=std::vector<int>(),
+                       int max_payload_len=4096,
+                       bool raw_pdus=false);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_OFDM_RX_H */
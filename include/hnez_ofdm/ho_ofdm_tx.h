@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_OFDM_TX_H
+#define INCLUDED_HNEZ_OFDM_HO_OFDM_TX_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief The complete transmitter in one block
+     * \ingroup hnez_ofdm
+     *
+     * Turns every packet of bytes into a frame of OFDM symbols,
+     * doing the same as the chain
+     * ho_add_header -> ho_fec -> ho_interleave -> ho_qam4_multimod
+     * -> ho_assign_carriers -> ho_add_schmidlcox -> ho_ifft_cyclicprefix,
+     * without passing the intermediate results through
+     * the scheduler's buffers.
+     *
+     * The interleaver works on chunks of one OFDM symbol
+     * (num_carriers/4 bytes), so num_carriers has to be a multiple of four.
+     * The output vectors of fft_len + cp_len samples are not scaled.
+     * The remaining parameters are those of ho_assign_carriers
+     * and ho_ifft_cyclicprefix.
+     */
+    class HNEZ_OFDM_API ho_ofdm_tx : virtual public gr::tagged_stream_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_ofdm_tx> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_ofdm_tx.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_ofdm_tx's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_ofdm_tx::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int fft_len, int cp_len, int num_carriers,
+                       bool contiguous=false, const gr_complex &fill=gr_complex(1, 0),
+                       const std::vector<int> &pilot_carriers=std::vector<int>(),
+                       const std::vector<gr_complex> &pilot_symbols=std::vector<gr_complex>(),
+                       int window_len=0,
+                       const std::string &len_tag_key="packet_len");
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_OFDM_TX_H */
@@ -23,17 +23,21 @@
 #define INCLUDED_HNEZ_OFDM_HO_QAM4_MULTIMOD_H
 
 #include <hnez_ofdm/api.h>
-#include <gnuradio/sync_decimator.h>
+#include <gnuradio/tagged_stream_block.h>
 
 namespace gr {
   namespace hnez_ofdm {
 
     /*!
-     * \brief <+description of block+>
+     * \brief QPSK modulator with vector output
      * \ingroup hnez_ofdm
      *
+     * Maps every byte of a tagged stream packet to four QPSK symbols,
+     * MSB first, and outputs vectors of output_width symbols.
+     * A packet that does not fill the last vector is padded
+     * with zero bytes.
      */
-    class HNEZ_OFDM_API ho_qam4_multimod : virtual public gr::sync_decimator
+    class HNEZ_OFDM_API ho_qam4_multimod : virtual public gr::tagged_stream_block
     {
      public:
       typedef boost::shared_ptr<ho_qam4_multimod> sptr;
@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_QAM4_SOFT_DEMOD_H
+#define INCLUDED_HNEZ_OFDM_HO_QAM4_SOFT_DEMOD_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief Soft decision demapper for ho_qam4_multimod symbols
+     * \ingroup hnez_ofdm
+     *
+     * Outputs one log-likelihood ratio, log(P(bit=0)/P(bit=1)),
+     * per bit for a stream of QPSK symbols.
+     *
+     * ho_qam4_multimod maps the bits of a byte MSB first,
+     * the output of this block is reordered to be LSB first:
+     * output k is the LLR of bit k%8 of byte k/8.
+     * This is the order used by ho_interleave and the hamming blocks.
+     *
+     * Every four input symbols produce eight outputs.
+     * When a packet ends in the middle of a byte the
+     * missing bits get an LLR of zero.
+     *
+     * noise_var is the variance of the (complex) noise on the
+     * symbols. It only scales the output and does not influence
+     * decisions made by ho_hamming74_soft.
+     */
+    class HNEZ_OFDM_API ho_qam4_soft_demod : virtual public gr::tagged_stream_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_qam4_soft_demod> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_qam4_soft_demod.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_qam4_soft_demod's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_qam4_soft_demod::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(float noise_var=1.0, const std::string& len_tag_key="packet_len");
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_QAM4_SOFT_DEMOD_H */
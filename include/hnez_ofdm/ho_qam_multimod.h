@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_QAM_MULTIMOD_H
+#define INCLUDED_HNEZ_OFDM_HO_QAM_MULTIMOD_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief Gray mapped square QAM modulator with vector output
+     * \ingroup hnez_ofdm
+     *
+     * Maps bits_per_symbol (2, 4, 6 or 8) bits, MSB first,
+     * to one symbol of a 4-, 16-, 64- or 256-QAM constellation
+     * and outputs vectors of output_width symbols.
+     * The upper half of the bits of a symbol select the real,
+     * the lower half the imaginary part.
+     * Using two bits per symbol gives the same output as ho_qam4_multimod.
+     *
+     * output_width * bits_per_symbol has to be a multiple of 8,
+     * for 64-QAM output_width has to be a multiple of 4.
+     * A packet that does not fill the last vector is padded
+     * with zero bytes.
+     */
+    class HNEZ_OFDM_API ho_qam_multimod : virtual public gr::tagged_stream_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_qam_multimod> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_qam_multimod.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_qam_multimod's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_qam_multimod::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(int bits_per_symbol, int output_width,
+                       const std::string &len_tag_key="packet_len");
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_QAM_MULTIMOD_H */
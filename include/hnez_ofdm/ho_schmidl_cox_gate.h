@@ -45,8 +45,63 @@ namespace gr {
        * constructor is in a private implementation
        * class. hnez_ofdm::ho_schmidl_cox_gate::make is the public interface for
        * creating new instances.
+       *
+       * Once the gate found a frame it outputs symbols until
+       * the next frame is detected or the frame is ended by
+       * a frame_ack message. A max_frame_symbols larger than zero
+       * additionally limits the number of symbols output per frame
+       * (including the two preamble symbols).
+       *
+       * The maximum of the Schmidl & Cox metric lies anywhere on
+       * the plateau caused by the cyclic prefix. With fine_timing set
+       * the frame start is refined by correlating the samples around
+       * the detected peak with the known waveform of the
+       * first preamble symbol (as sent by ho_add_schmidlcox and
+       * ho_ofdm_tx with fft_shift). Output symbols then start
+       * cp_len/8 samples before the strongest path
+       * to leave some margin for earlier, weaker paths.
+       *
+       * The frequency offset estimated from the phase of the
+       * preamble correlation is ambiguous by multiples of two
+       * carrier spacings. With max_cfo_carriers larger than zero
+       * this ambiguity is resolved by comparing the spectra of both
+       * preamble symbols (the differentially coded second preamble
+       * of Schmidl & Cox), allowing offsets of up to about
+       * max_cfo_carriers carrier spacings. It has to be smaller
+       * than fft_len/2. The total compensation per sample, in radians,
+       * is put into the fq_compensation tag of every frame.
+       */
+      static sptr make(int fft_len, int cp_len, float rel_pw_lo, float rel_pw_hi,
+                       bool block_metric=true, int num_threads=1,
+                       bool fft_out=false, bool fft_shift=true,
+                       int max_frame_symbols=0, bool fine_timing=false,
+                       int max_cfo_carriers=0);
+
+      /*!
+       * \brief Counters and histograms collected since the block was created
+       *
+       * Returns a dict with the number of samples_scanned,
+       * preambles_detected, realign_failures, frames_aborted
+       * (frames cut short by the detection of a new preamble)
+       * and frames_acked.
+       * preamble_power_hist is a u64vector counting the detected
+       * preambles by their relative power in bins of 1/16 from 0 to 1,
+       * cfo_hist counts them by their frequency offset in 16 bins
+       * from -r to +r carrier spacings, where r is max_cfo_carriers + 1.
+       * Values outside of the histograms go to the first or last bin.
+       *
+       * The same dict is published on the stats port every
+       * stats_interval input samples.
+       * Safe to call while the flowgraph is running.
+       */
+      virtual pmt::pmt_t get_stats() = 0;
+
+      /*!
+       * \brief Publish the statistics every num_samples input samples
+       *
+       * Defaults to 2^20 samples, 0 disables the stats port.
        */
-      static sptr make(int fft_len, int cp_len, float rel_pw_lo, float rel_pw_hi);
+      virtual void set_stats_interval(int num_samples) = 0;
     };
 
   } // namespace hnez_ofdm
@@ -0,0 +1,58 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_STRIP_HEADER_H
+#define INCLUDED_HNEZ_OFDM_HO_STRIP_HEADER_H
+
+#include <hnez_ofdm/api.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /*!
+     * \brief Check and remove the header added by ho_add_header
+     * \ingroup hnez_ofdm
+     *
+     * Packets whose length field exceeds the packet length
+     * or whose CRC does not match the payload are dropped.
+     * The payload of all other packets is output, padding
+     * behind the payload (e.g. from ho_hamming74_packed) is removed.
+     */
+    class HNEZ_OFDM_API ho_strip_header : virtual public gr::tagged_stream_block
+    {
+     public:
+      typedef boost::shared_ptr<ho_strip_header> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of hnez_ofdm::ho_strip_header.
+       *
+       * To avoid accidental use of raw pointers, hnez_ofdm::ho_strip_header's
+       * constructor is in a private implementation
+       * class. hnez_ofdm::ho_strip_header::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(const std::string& len_tag_key);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_STRIP_HEADER_H */
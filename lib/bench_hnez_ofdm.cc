@@ -0,0 +1,775 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Throughput benchmarks for the blocks in this module.
+ *
+ * The "work" benchmarks call the work functions of a block directly
+ * on synthetic buffers, without a scheduler, and show the cost
+ * of the signal processing alone.
+ * The "flowgraph" benchmarks run blocks in a flowgraph of the form
+ * vector_source -> head -> [tagger ->] blocks -> null_sink and
+ * include the scheduler overhead.
+ *
+ * The results are printed as JSON. For every benchmark the rate is
+ * given in input items (bytes or complex samples) and input bytes
+ * per second and, on x86, in TSC cycles per input item.
+ *
+ * Usage: bench-hnez_ofdm [num_items] [work|flowgraph]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/top_block.h>
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
+#include <gnuradio/prefs.h>
+#include <gnuradio/blocks/vector_source_b.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#include <gnuradio/blocks/stream_to_tagged_stream.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/fft/fft_vcc.h>
+#include <hnez_ofdm/ho_schmidl_cox_gate.h>
+#include <hnez_ofdm/ho_qam4_multimod.h>
+#include <hnez_ofdm/ho_qam_multimod.h>
+#include <hnez_ofdm/ho_add_header.h>
+#include <hnez_ofdm/ho_hamming74.h>
+#include <hnez_ofdm/ho_hamming74_packed.h>
+#include <hnez_ofdm/ho_interleave.h>
+#include <hnez_ofdm/ho_assign_carriers.h>
+#include <hnez_ofdm/ho_add_schmidlcox.h>
+#include <hnez_ofdm/ho_add_cyclicprefix.h>
+#include <hnez_ofdm/ho_ofdm_tx.h>
+#include <volk/volk.h>
+
+#include <boost/random.hpp>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLE_COUNTER 1
+#else
+#define HAVE_CYCLE_COUNTER 0
+#endif
+
+namespace {
+  typedef std::chrono::steady_clock bench_clock;
+
+  /* Every work benchmark repeats its work calls for this long */
+  const double work_seconds= 0.25;
+
+  uint64_t
+  read_cycles()
+  {
+#if HAVE_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  }
+
+  struct measurement {
+    uint64_t items;
+    double seconds;
+    uint64_t cycles;
+  };
+
+  /* Measures the time and cycles between start() and stop() */
+  class stopwatch {
+  private:
+    bench_clock::time_point d_start_time;
+    uint64_t d_start_cycles;
+
+  public:
+    void start()
+    {
+      d_start_time= bench_clock::now();
+      d_start_cycles= read_cycles();
+    }
+
+    measurement stop(uint64_t items)
+    {
+      uint64_t end_cycles= read_cycles();
+      bench_clock::time_point end_time= bench_clock::now();
+
+      measurement m;
+      m.items= items;
+      m.seconds= std::chrono::duration<double>(end_time - d_start_time).count();
+      m.cycles= end_cycles - d_start_cycles;
+
+      return m;
+    }
+
+    double elapsed()
+    {
+      return std::chrono::duration<double>(bench_clock::now() - d_start_time).count();
+    }
+  };
+
+  /* Collects the parameters of a benchmark as JSON members */
+  class params {
+  private:
+    std::string d_json;
+
+  public:
+    params &add(const char *name, long value)
+    {
+      char buf[64];
+      snprintf(buf, sizeof(buf), "%s\"%s\": %ld", d_json.empty() ? "" : ", ", name, value);
+      d_json+= buf;
+
+      return *this;
+    }
+
+    const std::string &json() const
+    {
+      return d_json;
+    }
+  };
+
+  /* Prints one JSON object with a list of all results */
+  class report {
+  private:
+    bool d_first;
+
+  public:
+    report() : d_first(true)
+    {
+      printf("{\n  \"cycle_counter\": %s,\n  \"benchmarks\": [", HAVE_CYCLE_COUNTER ? "\"tsc\"" : "null");
+    }
+
+    ~report()
+    {
+      printf("\n  ]\n}\n");
+    }
+
+    void add(const char *mode, const char *block, const params &p,
+             size_t item_size, const measurement &m)
+    {
+      double items_per_s= m.items / m.seconds;
+
+      printf("%s\n    {\"mode\": \"%s\", \"block\": \"%s\", \"params\": {%s}, "
+             "\"items\": %llu, \"seconds\": %.6f, "
+             "\"items_per_s\": %.1f, \"bytes_per_s\": %.1f, ",
+             d_first ? "" : ",", mode, block, p.json().c_str(),
+             (unsigned long long)m.items, m.seconds,
+             items_per_s, items_per_s * item_size);
+
+      if(HAVE_CYCLE_COUNTER) {
+        printf("\"cycles_per_item\": %.3f}", (double)m.cycles / m.items);
+      }
+      else {
+        printf("\"cycles_per_item\": null}");
+      }
+
+      fflush(stdout);
+      d_first= false;
+    }
+  };
+
+  std::vector<uint8_t>
+  make_bytes(size_t len)
+  {
+    std::vector<uint8_t> data(len);
+
+    for(size_t i=0; i<data.size(); i++) {
+      data[i]= (i * 37) ^ (i >> 8);
+    }
+
+    return data;
+  }
+
+  std::vector<gr_complex>
+  make_symbols(size_t len)
+  {
+    boost::mt19937 rng(23);
+    boost::normal_distribution<float> normal(0, 1);
+
+    std::vector<gr_complex> symbols(len);
+
+    for(size_t i=0; i<symbols.size(); i++) {
+      symbols[i]= gr_complex(normal(rng), normal(rng));
+    }
+
+    return symbols;
+  }
+
+  /* Generate a stream of frames that look like the ones
+   * produced by the transmit chain in ofdm_enc.grc:
+   * A Schmidl & Cox preamble (two identical halves),
+   * some payload symbols and a gap of low level noise.
+   * Every symbol is prefixed by a cyclic prefix and the
+   * whole signal has a small frequency offset applied. */
+  std::vector<gr_complex>
+  make_frames(int fft_len, int cp_len, int num_frames, int num_symbols)
+  {
+    boost::mt19937 rng(42);
+    boost::normal_distribution<float> normal(0, 1);
+
+    std::vector<gr_complex> frames;
+    std::vector<gr_complex> symbol(fft_len);
+
+    for(int frame=0; frame<num_frames; frame++) {
+      for(int i=0; i<(fft_len * 4); i++) {
+        frames.push_back(gr_complex(normal(rng), normal(rng)) * 0.01f);
+      }
+
+      for(int sym=0; sym<num_symbols; sym++) {
+        for(int i=0; i<fft_len; i++) {
+          if((sym == 0) && (i >= fft_len/2)) {
+            symbol[i]= symbol[i - fft_len/2];
+          }
+          else {
+            symbol[i]= gr_complex(normal(rng), normal(rng));
+          }
+        }
+
+        frames.insert(frames.end(), symbol.end() - cp_len, symbol.end());
+        frames.insert(frames.end(), symbol.begin(), symbol.end());
+      }
+    }
+
+    for(size_t i=0; i<frames.size(); i++) {
+      frames[i]*= std::polar(1.0f, 0.001f * i);
+    }
+
+    return frames;
+  }
+
+  /* Call the per-packet work() of a tagged stream block
+   * on the same packet over and over.
+   * packet_len is counted in input items of the block,
+   * the input and output buffers have to be large enough. */
+  measurement
+  run_work(boost::shared_ptr<gr::tagged_stream_block> block, int packet_len, int items_per_packet,
+           const void *in, void *out, int out_capacity)
+  {
+    gr_vector_int ninput_items(1, packet_len);
+    gr_vector_const_void_star input_items(1, in);
+    gr_vector_void_star output_items(1, out);
+
+    stopwatch sw;
+    uint64_t packets= 0;
+
+    sw.start();
+
+    do {
+      for(int i=0; i<64; i++) {
+        block->work(out_capacity, ninput_items, input_items, output_items);
+      }
+
+      packets+= 64;
+    } while(sw.elapsed() < work_seconds);
+
+    return sw.stop(packets * items_per_packet);
+  }
+
+  /* Same for sync blocks, processing num_items input items per call */
+  measurement
+  run_work(boost::shared_ptr<gr::sync_block> block, int num_items, int items_per_item,
+           const void *in, void *out)
+  {
+    gr_vector_const_void_star input_items(1, in);
+    gr_vector_void_star output_items(1, out);
+
+    stopwatch sw;
+    uint64_t calls= 0;
+
+    sw.start();
+
+    do {
+      for(int i=0; i<64; i++) {
+        block->work(num_items, input_items, output_items);
+      }
+
+      calls+= 64;
+    } while(sw.elapsed() < work_seconds);
+
+    return sw.stop(calls * num_items * items_per_item);
+  }
+
+  /* The gate needs nitems_read() and add_item_tag(), so it is
+   * given a block detail with buffers that are never actually used.
+   * The signal is looped and fed to general_work() in chunks */
+  void
+  bench_work_schmidl_cox_gate(report &rep)
+  {
+    const int fft_lens[]= {64, 128, 256, 512, 1024};
+    const int cp_divs[]= {16, 8, 4};
+    const int chunk_len= 8192;
+
+    for(size_t i=0; i<(sizeof(fft_lens)/sizeof(fft_lens[0])); i++) {
+      for(size_t c=0; c<(sizeof(cp_divs)/sizeof(cp_divs[0])); c++) {
+        for(int block_metric=0; block_metric<2; block_metric++) {
+          int fft_len= fft_lens[i];
+          int cp_len= fft_len / cp_divs[c];
+
+          std::vector<gr_complex> frames= make_frames(fft_len, cp_len, 16, 12);
+          size_t frames_len= frames.size();
+
+          // Room for the history in front of and a chunk behind every position
+          std::vector<gr_complex> signal;
+
+          for(int rep_idx=0; rep_idx<3; rep_idx++) {
+            signal.insert(signal.end(), frames.begin(), frames.end());
+          }
+
+          gr::hnez_ofdm::ho_schmidl_cox_gate::sptr gate=
+            gr::hnez_ofdm::ho_schmidl_cox_gate::make(fft_len, cp_len, 0.7, 0.8,
+                                                     block_metric, 1);
+
+          gr::block_detail_sptr detail= gr::make_block_detail(1, 1);
+          gr::buffer_sptr in_buf= gr::make_buffer(chunk_len, sizeof(gr_complex));
+          gr::buffer_sptr out_buf= gr::make_buffer(chunk_len, sizeof(gr_complex) * fft_len);
+
+          detail->set_input(0, gr::buffer_add_reader(in_buf, 0));
+          detail->set_output(0, out_buf);
+          gate->set_detail(detail);
+
+          int noutput_items= chunk_len / (fft_len + cp_len) + 1;
+          std::vector<gr_complex> out(noutput_items * fft_len);
+
+          int history= gate->history() - 1;
+
+          gr_vector_int ninput_items(1, chunk_len);
+          gr_vector_const_void_star input_items(1);
+          gr_vector_void_star output_items(1, &out[0]);
+
+          stopwatch sw;
+          sw.start();
+
+          do {
+            uint64_t pos= gate->nitems_read(0) % frames_len;
+
+            input_items[0]= &signal[frames_len + pos - history];
+            gate->general_work(noutput_items, ninput_items, input_items, output_items);
+          } while(sw.elapsed() < work_seconds);
+
+          rep.add("work", "ho_schmidl_cox_gate",
+                  params().add("fft_len", fft_len).add("cp_len", cp_len)
+                  .add("block_metric", block_metric),
+                  sizeof(gr_complex), sw.stop(gate->nitems_read(0)));
+
+          gate->set_detail(gr::block_detail_sptr());
+        }
+      }
+    }
+  }
+
+  /* The per-symbol frequency compensation of the gate, outside of
+   * the gate so that both variants can be compared:
+   * cp_rot=0 is the old code, which renormalized the phase accumulator
+   * with abs() and skipped the cyclic prefix with pow(),
+   * cp_rot=1 is the first order renormalization and the precomputed
+   * rotation over the cyclic prefix the gate uses now */
+  void
+  bench_work_fq_compensation(report &rep)
+  {
+    const int fft_lens[]= {64, 128, 256, 512, 1024};
+    const int num_symbols= 64;
+
+    for(size_t i=0; i<(sizeof(fft_lens)/sizeof(fft_lens[0])); i++) {
+      int fft_len= fft_lens[i];
+      int cp_len= fft_len / 8;
+      int sym_len= fft_len + cp_len;
+
+      std::vector<gr_complex> in= make_symbols(num_symbols * sym_len);
+      std::vector<gr_complex> out(num_symbols * fft_len);
+
+      gr_complex phase_rot= std::polar(1.0f, -0.3f / fft_len);
+      gr_complex cp_rot= std::polar(1.0f, -0.3f / fft_len * cp_len);
+
+      for(int use_cp_rot=0; use_cp_rot<2; use_cp_rot++) {
+        gr_complex phase_acc= 1;
+
+        stopwatch sw;
+        uint64_t calls= 0;
+
+        sw.start();
+
+        do {
+          for(int sym=0; sym<num_symbols; sym++) {
+            if(use_cp_rot) {
+              phase_acc*= 1.5f - 0.5f * std::norm(phase_acc);
+            }
+            else {
+              phase_acc/= std::abs(phase_acc);
+            }
+
+            volk_32fc_s32fc_x2_rotator_32fc(&out[sym * fft_len],
+                                            &in[sym * sym_len + cp_len],
+                                            phase_rot, &phase_acc, fft_len);
+
+            if(use_cp_rot) {
+              phase_acc*= cp_rot;
+            }
+            else {
+              phase_acc*= std::pow(phase_rot, cp_len);
+            }
+          }
+
+          calls++;
+        } while(sw.elapsed() < work_seconds);
+
+        rep.add("work", "ho_schmidl_cox_gate(fq_compensation)",
+                params().add("fft_len", fft_len).add("cp_len", cp_len)
+                .add("cp_rot", use_cp_rot),
+                sizeof(gr_complex), sw.stop(calls * num_symbols * sym_len));
+      }
+    }
+  }
+
+  /* The byte oriented tagged stream blocks for different packet sizes */
+  void
+  bench_work_byte_blocks(report &rep)
+  {
+    const int packet_lens[]= {16, 64, 256, 1024, 4096};
+
+    std::vector<uint8_t> in= make_bytes(4096 * 2);
+    std::vector<uint8_t> out_bytes(4096 * 4);
+    std::vector<gr_complex> out_symbols(4096 * 4 + 108);
+
+    for(size_t i=0; i<(sizeof(packet_lens)/sizeof(packet_lens[0])); i++) {
+      int packet_len= packet_lens[i];
+      params p= params().add("packet_len", packet_len);
+
+      rep.add("work", "ho_add_header", p, sizeof(uint8_t),
+              run_work(gr::hnez_ofdm::ho_add_header::make("packet_len"),
+                       packet_len, packet_len, &in[0], &out_bytes[0], out_bytes.size()));
+
+      rep.add("work", "ho_hamming74(encode)", p, sizeof(uint8_t),
+              run_work(gr::hnez_ofdm::ho_hamming74::make(true),
+                       packet_len, packet_len, &in[0], &out_bytes[0], out_bytes.size()));
+
+      rep.add("work", "ho_hamming74_packed(encode)", p, sizeof(uint8_t),
+              run_work(gr::hnez_ofdm::ho_hamming74_packed::make(true),
+                       packet_len, packet_len, &in[0], &out_bytes[0], out_bytes.size()));
+
+      rep.add("work", "ho_hamming74_packed(decode)", p, sizeof(uint8_t),
+              run_work(gr::hnez_ofdm::ho_hamming74_packed::make(false),
+                       packet_len, packet_len, &in[0], &out_bytes[0], out_bytes.size()));
+
+      rep.add("work", "ho_interleave", params(p).add("chunk_len", 27), sizeof(uint8_t),
+              run_work(gr::hnez_ofdm::ho_interleave::make(27, true),
+                       packet_len, packet_len, &in[0], &out_bytes[0], out_bytes.size()));
+
+      rep.add("work", "ho_qam4_multimod", params(p).add("output_width", 108), sizeof(uint8_t),
+              run_work(gr::hnez_ofdm::ho_qam4_multimod::make(108),
+                       packet_len, packet_len, &in[0], &out_symbols[0],
+                       out_symbols.size() / 108));
+    }
+  }
+
+  /* The symbol oriented blocks for different FFT lengths,
+   * with packets of 16 OFDM symbols */
+  void
+  bench_work_symbol_blocks(report &rep)
+  {
+    const int fft_lens[]= {64, 128, 256, 512, 1024};
+    const int cp_divs[]= {16, 8, 4};
+    const int num_symbols= 16;
+
+    for(size_t i=0; i<(sizeof(fft_lens)/sizeof(fft_lens[0])); i++) {
+      int fft_len= fft_lens[i];
+
+      // The ratio of ofdm_enc.grc, rounded to a multiple of four
+      int num_carriers= ((fft_len * 27) / 32) & ~3;
+
+      std::vector<gr_complex> in= make_symbols(num_symbols * fft_len);
+      std::vector<gr_complex> out((num_symbols + 2) * fft_len * 2);
+
+      rep.add("work", "ho_assign_carriers",
+              params().add("fft_len", fft_len).add("num_carriers", num_carriers)
+              .add("num_symbols", num_symbols),
+              sizeof(gr_complex),
+              run_work(gr::hnez_ofdm::ho_assign_carriers::make(num_carriers, fft_len),
+                       num_symbols, num_symbols * num_carriers,
+                       &in[0], &out[0], num_symbols + 2));
+
+      rep.add("work", "ho_add_schmidlcox",
+              params().add("fft_len", fft_len).add("num_symbols", num_symbols),
+              sizeof(gr_complex),
+              run_work(gr::hnez_ofdm::ho_add_schmidlcox::make(fft_len),
+                       num_symbols, num_symbols * fft_len,
+                       &in[0], &out[0], num_symbols + 2));
+
+      for(size_t c=0; c<(sizeof(cp_divs)/sizeof(cp_divs[0])); c++) {
+        int cp_len= fft_len / cp_divs[c];
+
+        rep.add("work", "ho_add_cyclicprefix",
+                params().add("fft_len", fft_len).add("cp_len", cp_len)
+                .add("num_symbols", num_symbols),
+                sizeof(gr_complex),
+                run_work(gr::hnez_ofdm::ho_add_cyclicprefix::make(fft_len, cp_len),
+                         num_symbols, fft_len, &in[0], &out[0]));
+      }
+    }
+  }
+
+  /* Push num_items from src through the chain of blocks */
+  measurement
+  run_flowgraph(gr::basic_block_sptr src, size_t in_itemsize, uint64_t num_items,
+                const std::vector<gr::basic_block_sptr> &chain, size_t out_itemsize)
+  {
+    gr::top_block_sptr tb= gr::make_top_block("bench");
+
+    gr::blocks::head::sptr head=
+      gr::blocks::head::make(in_itemsize, num_items);
+    gr::blocks::null_sink::sptr sink=
+      gr::blocks::null_sink::make(out_itemsize);
+
+    gr::basic_block_sptr prev= head;
+
+    tb->connect(src, 0, head, 0);
+
+    for(size_t i=0; i<chain.size(); i++) {
+      tb->connect(prev, 0, chain[i], 0);
+      prev= chain[i];
+    }
+
+    tb->connect(prev, 0, sink, 0);
+
+    stopwatch sw;
+
+    sw.start();
+    tb->run();
+
+    return sw.stop(num_items);
+  }
+
+  measurement
+  run_flowgraph(const std::vector<gr_complex> &signal, uint64_t num_items,
+                gr::basic_block_sptr block, size_t out_itemsize)
+  {
+    return run_flowgraph(gr::blocks::vector_source_c::make(signal, true),
+                         sizeof(gr_complex), num_items,
+                         std::vector<gr::basic_block_sptr>(1, block), out_itemsize);
+  }
+
+  void
+  bench_schmidl_cox_gate(report &rep, uint64_t num_items)
+  {
+    const int fft_lens[]= {64, 128, 256, 512, 1024};
+
+    for(size_t i=0; i<(sizeof(fft_lens)/sizeof(fft_lens[0])); i++) {
+      int fft_len= fft_lens[i];
+      int cp_len= fft_len / 8;
+
+      std::vector<gr_complex> signal= make_frames(fft_len, cp_len, 16, 12);
+
+      /* (block_metric, fft_out) pairs to measure */
+      const bool variants[][2]= {{false, false}, {true, false}, {true, true}};
+
+      for(size_t v=0; v<(sizeof(variants)/sizeof(variants[0])); v++) {
+        bool block_metric= variants[v][0];
+        bool fft_out= variants[v][1];
+
+        gr::hnez_ofdm::ho_schmidl_cox_gate::sptr gate=
+          gr::hnez_ofdm::ho_schmidl_cox_gate::make(fft_len, cp_len, 0.7, 0.8,
+                                                   block_metric, 1, fft_out);
+
+        rep.add("flowgraph", "ho_schmidl_cox_gate",
+                params().add("fft_len", fft_len).add("cp_len", cp_len)
+                .add("block_metric", block_metric).add("fft_out", fft_out),
+                sizeof(gr_complex),
+                run_flowgraph(signal, num_items, gate, sizeof(gr_complex) * fft_len));
+      }
+    }
+  }
+
+  /* The modulators are fed packets of a fixed length.
+   * Small packets show the per-packet overhead
+   * (length tags, scheduler calls) */
+  void
+  bench_qam_multimod(report &rep, uint64_t num_items)
+  {
+    const int packet_lens[]= {16, 64, 256, 1024, 4096, 9216};
+    const int output_width= 64;
+
+    std::vector<uint8_t> data= make_bytes(1 << 16);
+
+    for(size_t i=0; i<(sizeof(packet_lens)/sizeof(packet_lens[0])); i++) {
+      int packet_len= packet_lens[i];
+      uint64_t num_bytes= (num_items / packet_len) * packet_len;
+
+      for(int bits_per_symbol=2; bits_per_symbol<=4; bits_per_symbol+=2) {
+        std::vector<gr::basic_block_sptr> chain;
+
+        chain.push_back(gr::blocks::stream_to_tagged_stream::make(sizeof(uint8_t), 1,
+                                                                  packet_len,
+                                                                  "packet_len"));
+
+        if(bits_per_symbol == 2) {
+          chain.push_back(gr::hnez_ofdm::ho_qam4_multimod::make(output_width));
+        }
+        else {
+          chain.push_back(gr::hnez_ofdm::ho_qam_multimod::make(bits_per_symbol,
+                                                               output_width));
+        }
+
+        rep.add("flowgraph",
+                (bits_per_symbol == 2) ? "ho_qam4_multimod" : "ho_qam_multimod(16QAM)",
+                params().add("packet_len", packet_len).add("output_width", output_width),
+                sizeof(uint8_t),
+                run_flowgraph(gr::blocks::vector_source_b::make(data, true),
+                              sizeof(uint8_t), num_bytes, chain,
+                              sizeof(gr_complex) * output_width));
+      }
+    }
+  }
+
+  /* The byte level part of the transmitter for small packets,
+   * like the ~40 byte telemetry packets.
+   * The tagged stream blocks process all complete packets
+   * in their input buffer per call, so the packet rate should
+   * not be limited by the number of scheduler calls.
+   * batching=0 processes one packet per call, like before.
+   * The packet rate is items_per_s / packet_len */
+  void
+  bench_small_packets(report &rep, uint64_t num_items)
+  {
+    const int packet_lens[]= {8, 40, 256};
+
+    std::vector<uint8_t> data= make_bytes(1 << 16);
+
+    for(size_t i=0; i<(sizeof(packet_lens)/sizeof(packet_lens[0])); i++) {
+      int packet_len= packet_lens[i];
+      uint64_t num_bytes= ((num_items / 4) / packet_len) * packet_len;
+
+      for(int batching=0; batching<2; batching++) {
+        /* The blocks read the option when they are created */
+        gr::prefs::singleton()->set_bool("hnez_ofdm", "packet_batching", batching);
+
+        std::vector<gr::basic_block_sptr> chain;
+
+        chain.push_back(gr::blocks::stream_to_tagged_stream::make(sizeof(uint8_t), 1,
+                                                                  packet_len,
+                                                                  "packet_len"));
+        chain.push_back(gr::hnez_ofdm::ho_add_header::make("packet_len"));
+        chain.push_back(gr::hnez_ofdm::ho_hamming74_packed::make(true));
+        chain.push_back(gr::hnez_ofdm::ho_interleave::make(27, true));
+
+        rep.add("flowgraph", "header+fec+interleave",
+                params().add("packet_len", packet_len).add("batching", batching),
+                sizeof(uint8_t),
+                run_flowgraph(gr::blocks::vector_source_b::make(data, true),
+                              sizeof(uint8_t), num_bytes, chain, sizeof(uint8_t)));
+      }
+    }
+
+    gr::prefs::singleton()->set_bool("hnez_ofdm", "packet_batching", true);
+  }
+
+  /* The transmitter of examples/ofdm_enc.grc,
+   * once as a chain of blocks and once as ho_ofdm_tx */
+  void
+  bench_ofdm_tx(report &rep, uint64_t num_items)
+  {
+    const int packet_lens[]= {16, 64, 256, 1024};
+    const int fft_len= 128;
+    const int cp_len= 10;
+    const int num_carriers= 108;
+
+    std::vector<uint8_t> data= make_bytes(1 << 16);
+
+    for(size_t i=0; i<(sizeof(packet_lens)/sizeof(packet_lens[0])); i++) {
+      int packet_len= packet_lens[i];
+
+      // The transmitter is much slower than the other blocks
+      uint64_t num_bytes= ((num_items / 16) / packet_len) * packet_len;
+
+      for(int fused=0; fused<2; fused++) {
+        std::vector<gr::basic_block_sptr> chain;
+
+        chain.push_back(gr::blocks::stream_to_tagged_stream::make(sizeof(uint8_t), 1,
+                                                                  packet_len,
+                                                                  "packet_len"));
+
+        if(fused) {
+          chain.push_back(gr::hnez_ofdm::ho_ofdm_tx::make(fft_len, cp_len, num_carriers));
+        }
+        else {
+          chain.push_back(gr::hnez_ofdm::ho_add_header::make("packet_len"));
+          chain.push_back(gr::hnez_ofdm::ho_hamming74_packed::make(true));
+          chain.push_back(gr::hnez_ofdm::ho_interleave::make(num_carriers / 4, true));
+          chain.push_back(gr::hnez_ofdm::ho_qam4_multimod::make(num_carriers));
+          chain.push_back(gr::hnez_ofdm::ho_assign_carriers::make(num_carriers, fft_len));
+          chain.push_back(gr::hnez_ofdm::ho_add_schmidlcox::make(fft_len));
+          chain.push_back(gr::fft::fft_vcc::make(fft_len, false,
+                                                 std::vector<float>(), true));
+          chain.push_back(gr::hnez_ofdm::ho_add_cyclicprefix::make(fft_len, cp_len));
+        }
+
+        rep.add("flowgraph", fused ? "ho_ofdm_tx" : "tx chain",
+                params().add("packet_len", packet_len).add("fft_len", fft_len)
+                .add("cp_len", cp_len).add("num_carriers", num_carriers),
+                sizeof(uint8_t),
+                run_flowgraph(gr::blocks::vector_source_b::make(data, true),
+                              sizeof(uint8_t), num_bytes, chain,
+                              sizeof(gr_complex) * (fft_len + cp_len)));
+      }
+    }
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  uint64_t num_items= 20000000;
+  bool work_benchmarks= true;
+  bool flowgraph_benchmarks= true;
+
+  if(argc > 1) {
+    num_items= strtoull(argv[1], NULL, 0);
+  }
+
+  if(argc > 2) {
+    work_benchmarks= !strcmp(argv[2], "work");
+    flowgraph_benchmarks= !strcmp(argv[2], "flowgraph");
+  }
+
+  report rep;
+
+  if(work_benchmarks) {
+    bench_work_schmidl_cox_gate(rep);
+    bench_work_fq_compensation(rep);
+    bench_work_byte_blocks(rep);
+    bench_work_symbol_blocks(rep);
+  }
+
+  if(flowgraph_benchmarks) {
+    bench_schmidl_cox_gate(rep, num_items);
+    bench_qam_multimod(rep, num_items);
+    bench_small_packets(rep, num_items);
+    bench_ofdm_tx(rep, num_items);
+  }
+
+  return 0;
+}
@@ -23,8 +23,8 @@
 #endif
 
 #include <gnuradio/io_signature.h>
-#include <gnuradio/digital/crc32.h>
 #include "ho_add_header_impl.h"
+#include "ho_crc32.h"
 
 namespace gr {
   namespace hnez_ofdm {
@@ -71,7 +71,9 @@ namespace gr {
       uint8_t *out = (uint8_t *) output_items[0];
 
       uint32_t payload_len= ninput_items[0];
-      uint32_t crc= gr::digital::crc32(in, payload_len);
+
+      // The payload is read only once, to copy and checksum it
+      uint32_t crc= ho_crc32_copy(&out[8], in, payload_len);
 
       out[0]= (payload_len >> 24) & 0xff;
       out[1]= (payload_len >> 16) & 0xff;
@@ -83,8 +85,6 @@ namespace gr {
       out[6]= (crc >>  8) & 0xff;
       out[7]= (crc >>  0) & 0xff;
 
-      memcpy(&out[8], in, payload_len);
-
       // Tell runtime system how many output items we produced.
       return (payload_len + 8);
     }
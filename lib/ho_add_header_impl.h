@@ -22,11 +22,12 @@
 #define INCLUDED_HNEZ_OFDM_HO_ADD_HEADER_IMPL_H
 
 #include <hnez_ofdm/ho_add_header.h>
+#include "ho_packet_batch_block.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
-    class ho_add_header_impl : public ho_add_header
+    class ho_add_header_impl : public ho_packet_batch_block<ho_add_header>
     {
      private:
       // Nothing to declare in this block.
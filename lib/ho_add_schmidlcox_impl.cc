@@ -24,6 +24,7 @@
 
 #include <gnuradio/io_signature.h>
 #include "ho_add_schmidlcox_impl.h"
+#include "ho_schmidlcox_preamble.h"
 
 namespace gr {
   namespace hnez_ofdm {
@@ -46,22 +47,7 @@ namespace gr {
     {
       this->fft_len= fft_len;
 
-      preamble_a= new gr_complex[fft_len];
-      preamble_b= new gr_complex[fft_len];
-
-      uint32_t lfsr_state= 1;
-
-      for(int i=0; i<fft_len; i++) {
-        preamble_a[i]= gr_complex(lfsr(&lfsr_state) ? M_SQRT2 : -M_SQRT2,
-                                  lfsr(&lfsr_state) ? M_SQRT2 : -M_SQRT2);
-
-        preamble_b[i]= gr_complex(lfsr(&lfsr_state) ? M_SQRT1_2 : -M_SQRT1_2,
-                                  lfsr(&lfsr_state) ? M_SQRT1_2 : -M_SQRT1_2);
-
-        /* In the first preamble symbol only every
-           second carrier is occupied */
-        if (i%2) preamble_a[i]= 0;
-      }
+      ho_schmidlcox_preamble(fft_len, preamble_a, preamble_b);
     }
 
     /*
@@ -69,8 +55,6 @@ namespace gr {
      */
     ho_add_schmidlcox_impl::~ho_add_schmidlcox_impl()
     {
-      delete[] preamble_a;
-      delete[] preamble_b;
     }
 
     int
@@ -80,18 +64,6 @@ namespace gr {
       return noutput_items ;
     }
 
-    bool
-    ho_add_schmidlcox_impl::lfsr (uint32_t *state)
-    {
-      uint_fast8_t bit= (*state) & 1;
-
-      (*state)>>= 1;
-
-      if(bit) (*state)^= 0x80000057;
-
-      return bit;
-    }
-
     int
     ho_add_schmidlcox_impl::work (int noutput_items,
                                   gr_vector_int &ninput_items,
@@ -110,8 +82,8 @@ namespace gr {
 
       size_t chunk_size= sizeof(gr_complex) * fft_len;
 
-      memcpy(out, preamble_a, chunk_size);
-      memcpy(&out[fft_len], preamble_b, chunk_size);
+      memcpy(out, &preamble_a[0], chunk_size);
+      memcpy(&out[fft_len], &preamble_b[0], chunk_size);
       memcpy(&out[fft_len*2], in, chunk_size * in_count);
 
       // Tell runtime system how many output items we produced.
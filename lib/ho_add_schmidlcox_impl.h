@@ -22,20 +22,19 @@
 #define INCLUDED_HNEZ_OFDM_HO_ADD_SCHMIDLCOX_IMPL_H
 
 #include <hnez_ofdm/ho_add_schmidlcox.h>
+#include "ho_packet_batch_block.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
-    class ho_add_schmidlcox_impl : public ho_add_schmidlcox
+    class ho_add_schmidlcox_impl : public ho_packet_batch_block<ho_add_schmidlcox>
     {
     private:
       int fft_len;
 
-      gr_complex *preamble_a;
-      gr_complex *preamble_b;
+      std::vector<gr_complex> preamble_a;
+      std::vector<gr_complex> preamble_b;
 
-      bool lfsr (uint32_t *state);
-      
     protected:
       int calculate_output_stream_length(const gr_vector_int &ninput_items);
 
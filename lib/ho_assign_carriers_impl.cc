@@ -23,35 +23,63 @@
 #endif
 
 #include <gnuradio/io_signature.h>
+#include <stdexcept>
 #include "ho_assign_carriers_impl.h"
+#include "ho_carrier_layout.h"
+#include "ho_schmidlcox_preamble.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
     ho_assign_carriers::sptr
-    ho_assign_carriers::make(int num_carriers, int fft_len, const std::string& len_tag_key)
+    ho_assign_carriers::make(int num_carriers, int fft_len, const std::string& len_tag_key,
+                             bool contiguous, const gr_complex &fill,
+                             const std::vector<int> &pilot_carriers,
+                             const std::vector<gr_complex> &pilot_symbols,
+                             bool add_preamble)
     {
       return gnuradio::get_initial_sptr
-        (new ho_assign_carriers_impl(num_carriers, fft_len, len_tag_key));
+        (new ho_assign_carriers_impl(num_carriers, fft_len, len_tag_key,
+                                     contiguous, fill,
+                                     pilot_carriers, pilot_symbols,
+                                     add_preamble));
     }
 
     /*
      * The private constructor
      */
-    ho_assign_carriers_impl::ho_assign_carriers_impl(int num_carriers, int fft_len, const std::string& len_tag_key)
+    ho_assign_carriers_impl::ho_assign_carriers_impl(int num_carriers, int fft_len, const std::string& len_tag_key,
+                                                     bool contiguous, const gr_complex &fill,
+                                                     const std::vector<int> &pilot_carriers,
+                                                     const std::vector<gr_complex> &pilot_symbols,
+                                                     bool add_preamble)
       : gr::tagged_stream_block("ho_assign_carriers",
                                 gr::io_signature::make(1, 1, sizeof(gr_complex) * num_carriers),
                                 gr::io_signature::make(1, 1, sizeof(gr_complex) * fft_len),
                                 len_tag_key)
     {
+      if(pilot_carriers.size() != pilot_symbols.size()) {
+        throw std::invalid_argument("ho_assign_carriers: need one pilot symbol per pilot carrier");
+      }
+
       this->num_carriers= num_carriers;
       this->fft_len= fft_len;
 
-      occupied_carriers= new bool[fft_len];
-      memset(occupied_carriers, 0, fft_len);
+      scatter_index= ho_carrier_layout(num_carriers, fft_len,
+                                       contiguous, pilot_carriers);
 
-      for(int i=0; i < num_carriers; i++) {
-        occupied_carriers[(fft_len * i)/num_carriers]= true;
+      /* Everything that is not overwritten by a data carrier
+       * is taken from the template symbol */
+      symbol_template.assign(fft_len, fill);
+
+      for(size_t i=0; i<pilot_carriers.size(); i++) {
+        symbol_template[pilot_carriers[i]]= pilot_symbols[i];
+      }
+
+      this->add_preamble= add_preamble;
+
+      if(add_preamble) {
+        ho_schmidlcox_preamble(fft_len, preamble_a, preamble_b);
       }
     }
 
@@ -60,13 +88,12 @@ namespace gr {
      */
     ho_assign_carriers_impl::~ho_assign_carriers_impl()
     {
-      delete[] occupied_carriers;
     }
 
     int
     ho_assign_carriers_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
     {
-      int noutput_items = ninput_items[0];
+      int noutput_items = ninput_items[0] + (add_preamble ? 2 : 0);
       return noutput_items ;
     }
 
@@ -80,24 +107,39 @@ namespace gr {
       gr_complex *out = (gr_complex *) output_items[0];
 
       int in_count= ninput_items[0];
+      int out_count= in_count;
+
+      /* Write the preamble directly in front of the payload
+       * instead of copying the whole frame in ho_add_schmidlcox */
+      if(add_preamble) {
+        out_count+= 2;
+
+        if(out_count > noutput_items) {
+          throw std::runtime_error("Output buffer to small!");
+        }
+
+        memcpy(out, &preamble_a[0], sizeof(gr_complex) * fft_len);
+        memcpy(&out[fft_len], &preamble_b[0], sizeof(gr_complex) * fft_len);
+
+        out+= 2 * fft_len;
+      }
+
+      const gr_complex *tmpl= &symbol_template[0];
+      const int *scatter= &scatter_index[0];
 
       for (int sym_num=0; sym_num < in_count; sym_num++) {
         const gr_complex *in_sym= &in[sym_num * num_carriers];
         gr_complex *out_sym= &out[sym_num * fft_len];
 
-        for(int ci=0, fi=0; fi<fft_len; fi++) {
-          if(occupied_carriers[fi]) {
-            out_sym[fi]= in_sym[ci];
-            ci++;
-          }
-          else {
-            out_sym[fi]= 1;
-          }
+        memcpy(out_sym, tmpl, sizeof(gr_complex) * fft_len);
+
+        for(int ci=0; ci<num_carriers; ci++) {
+          out_sym[scatter[ci]]= in_sym[ci];
         }
       }
 
       // Tell runtime system how many output items we produced.
-      return in_count;
+      return out_count;
     }
 
   } /* namespace hnez_ofdm */
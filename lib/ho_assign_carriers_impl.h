@@ -22,22 +22,35 @@
 #define INCLUDED_HNEZ_OFDM_HO_ASSIGN_CARRIERS_IMPL_H
 
 #include <hnez_ofdm/ho_assign_carriers.h>
+#include "ho_packet_batch_block.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
-    class ho_assign_carriers_impl : public ho_assign_carriers
+    class ho_assign_carriers_impl : public ho_packet_batch_block<ho_assign_carriers>
     {
     private:
       int num_carriers;
       int fft_len;
-      bool *occupied_carriers;
+
+      /* FFT bin of every data carrier and the symbol
+       * holding the fill value and pilots */
+      std::vector<int> scatter_index;
+      std::vector<gr_complex> symbol_template;
+
+      bool add_preamble;
+      std::vector<gr_complex> preamble_a;
+      std::vector<gr_complex> preamble_b;
 
     protected:
       int calculate_output_stream_length(const gr_vector_int &ninput_items);
 
     public:
-      ho_assign_carriers_impl(int num_carriers, int fft_len, const std::string& len_tag_key);
+      ho_assign_carriers_impl(int num_carriers, int fft_len, const std::string& len_tag_key,
+                              bool contiguous, const gr_complex &fill,
+                              const std::vector<int> &pilot_carriers,
+                              const std::vector<gr_complex> &pilot_symbols,
+                              bool add_preamble);
       ~ho_assign_carriers_impl();
 
       // Where all the action really happens
@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <volk/volk.h>
+#include "ho_carrier_equalizer.h"
+#include "ho_carrier_layout.h"
+#include "ho_schmidlcox_preamble.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_carrier_equalizer::ho_carrier_equalizer(int num_carriers, int fft_len, bool contiguous,
+                                               const std::vector<int> &pilot_carriers,
+                                               bool fft_shifted)
+      : d_num_carriers(num_carriers),
+        d_gather_index(ho_carrier_layout(num_carriers, fft_len,
+                                         contiguous, pilot_carriers)),
+        d_reference(num_carriers)
+    {
+      std::vector<gr_complex> preamble_a, preamble_b;
+      ho_schmidlcox_preamble(fft_len, preamble_a, preamble_b);
+
+      for(int ci=0; ci<num_carriers; ci++) {
+        d_reference[ci]= preamble_b[d_gather_index[ci]];
+
+        /* The transmitter undoes the shift by placing shifted bin s
+         * at bin s - fft_len/2 of its IFFT input */
+        if(!fft_shifted) {
+          d_gather_index[ci]= (d_gather_index[ci] + (fft_len + 1)/2) % fft_len;
+        }
+      }
+
+      d_taps= (gr_complex *)volk_malloc(sizeof(gr_complex) * num_carriers,
+                                        volk_get_alignment());
+
+      for(int ci=0; ci<num_carriers; ci++) {
+        d_taps[ci]= 1;
+      }
+    }
+
+    ho_carrier_equalizer::~ho_carrier_equalizer()
+    {
+      volk_free(d_taps);
+    }
+
+    void
+    ho_carrier_equalizer::estimate(const gr_complex *spectrum)
+    {
+      /* Zero-forcing estimate: the tap is the factor that turns
+       * the received preamble back into the one that was sent */
+      for(int ci=0; ci<d_num_carriers; ci++) {
+        gr_complex rx= spectrum[d_gather_index[ci]];
+        float power= norm(rx);
+
+        d_taps[ci]= (power > 0) ? (d_reference[ci] * conj(rx) / power) : gr_complex(0);
+      }
+    }
+
+    void
+    ho_carrier_equalizer::equalize(const gr_complex *spectrum, gr_complex *out) const
+    {
+      const int *gather= &d_gather_index[0];
+
+      for(int ci=0; ci<d_num_carriers; ci++) {
+        out[ci]= spectrum[gather[ci]];
+      }
+
+      volk_32fc_x2_multiply_32fc(out, out, d_taps, d_num_carriers);
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
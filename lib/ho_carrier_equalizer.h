@@ -0,0 +1,72 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_CARRIER_EQUALIZER_H
+#define INCLUDED_HNEZ_OFDM_HO_CARRIER_EQUALIZER_H
+
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Per-carrier channel estimation and equalization
+     * based on the preamble_b symbol of ho_add_schmidlcox.
+     *
+     * Spectra passed in are either fft shifted (DC in the center,
+     * like the output of ho_schmidl_cox_gate with fft_shift set)
+     * or in natural FFT order (DC at bin zero). */
+    class ho_carrier_equalizer
+    {
+    private:
+      const int d_num_carriers;
+
+      /* FFT bin of every data carrier and the
+       * preamble_b value sent on it */
+      std::vector<int> d_gather_index;
+      std::vector<gr_complex> d_reference;
+
+      /* Channel inverse per data carrier, aligned for volk */
+      gr_complex *d_taps;
+
+      // Not copyable, d_taps is owned
+      ho_carrier_equalizer(const ho_carrier_equalizer &);
+      ho_carrier_equalizer &operator=(const ho_carrier_equalizer &);
+
+    public:
+      /* The carrier layout parameters are those of ho_assign_carriers */
+      ho_carrier_equalizer(int num_carriers, int fft_len, bool contiguous,
+                           const std::vector<int> &pilot_carriers,
+                           bool fft_shifted);
+      ~ho_carrier_equalizer();
+
+      /* Estimate the channel from the spectrum of
+       * a received preamble_b symbol */
+      void estimate(const gr_complex *spectrum);
+
+      /* Gather the num_carriers data carriers of spectrum
+       * into out and remove the estimated channel */
+      void equalize(const gr_complex *spectrum, gr_complex *out) const;
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_CARRIER_EQUALIZER_H */
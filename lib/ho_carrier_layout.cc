@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdexcept>
+#include <algorithm>
+#include "ho_carrier_layout.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    std::vector<int>
+    ho_carrier_layout(int num_carriers, int fft_len, bool contiguous,
+                      const std::vector<int> &pilot_carriers)
+    {
+      if((fft_len <= 0) || (num_carriers <= 0) || (num_carriers > fft_len)) {
+        throw std::invalid_argument("ho_carrier_layout: num_carriers does not fit into fft_len");
+      }
+
+      std::vector<bool> used(fft_len, false);
+
+      for(size_t i=0; i<pilot_carriers.size(); i++) {
+        int bin= pilot_carriers[i];
+
+        if((bin < 0) || (bin >= fft_len) || used[bin]) {
+          throw std::invalid_argument("ho_carrier_layout: pilot carriers have to be unique bins within fft_len");
+        }
+
+        used[bin]= true;
+      }
+
+      std::vector<int> carriers;
+      carriers.reserve(num_carriers);
+
+      if(!contiguous) {
+        for(int i=0; i<num_carriers; i++) {
+          int bin= (fft_len * i)/num_carriers;
+
+          if(used[bin]) {
+            throw std::invalid_argument("ho_carrier_layout: pilot carrier collides with a data carrier");
+          }
+
+          carriers.push_back(bin);
+        }
+
+        return carriers;
+      }
+
+      /* Fill the bins alternately above and below DC,
+       * moving outwards until all carriers are placed */
+      int dc= fft_len/2;
+
+      for(int offset=1; (int)carriers.size() < num_carriers; offset++) {
+        if((dc + offset >= fft_len) && (dc - offset < 0)) {
+          throw std::invalid_argument("ho_carrier_layout: too many carriers for a contiguous layout");
+        }
+
+        if((dc + offset < fft_len) && !used[dc + offset]) {
+          carriers.push_back(dc + offset);
+        }
+
+        if(((int)carriers.size() < num_carriers) && (dc - offset >= 0) && !used[dc - offset]) {
+          carriers.push_back(dc - offset);
+        }
+      }
+
+      std::sort(carriers.begin(), carriers.end());
+
+      return carriers;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,46 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_CARRIER_LAYOUT_H
+#define INCLUDED_HNEZ_OFDM_HO_CARRIER_LAYOUT_H
+
+#include <vector>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Return the FFT bins (in fft shifted order, DC at fft_len/2)
+     * that carry the num_carriers data carriers, sorted ascending.
+     *
+     * The spread layout places carrier i at bin (fft_len * i)/num_carriers,
+     * like the transmitter always did.
+     * The contiguous layout uses the bins closest to DC, leaving
+     * the DC bin and the band edges free as guard carriers.
+     * Data carriers never share a bin with one of the pilot_carriers.
+     *
+     * Throws std::invalid_argument if the carriers do not fit. */
+    std::vector<int> ho_carrier_layout(int num_carriers, int fft_len,
+                                       bool contiguous,
+                                       const std::vector<int> &pilot_carriers);
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_CARRIER_LAYOUT_H */
@@ -0,0 +1,250 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstring>
+#include "ho_crc32.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HO_CRC32_HAVE_CLMUL
+#include <immintrin.h>
+#endif
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    namespace {
+      /* CRC-32 polynomial, processed MSB first */
+      const uint32_t poly= 0x04c11db7;
+
+      /* table[0] is the usual bytewise lookup table,
+       * table[n] advances the CRC of a byte by n more zero bytes.
+       * This allows processing eight bytes using eight independent
+       * lookups instead of a chain of eight dependent ones */
+      struct slicing_tables_t {
+        uint32_t table[8][256];
+
+        slicing_tables_t()
+        {
+          for(int i=0; i<256; i++) {
+            uint32_t crc= (uint32_t)i << 24;
+
+            for(int bit=0; bit<8; bit++) {
+              crc= (crc << 1) ^ ((crc & 0x80000000) ? poly : 0);
+            }
+
+            table[0][i]= crc;
+          }
+
+          for(int i=0; i<256; i++) {
+            for(int slice=1; slice<8; slice++) {
+              uint32_t prev= table[slice - 1][i];
+
+              table[slice][i]= (prev << 8) ^ table[0][prev >> 24];
+            }
+          }
+        }
+      };
+
+      const slicing_tables_t slicing_tables;
+
+      inline uint32_t
+      load_be32(const uint8_t *in)
+      {
+        return ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16)
+          | ((uint32_t)in[2] << 8) | ((uint32_t)in[3]);
+      }
+
+      template<bool copy> uint32_t
+      update_slicing(uint32_t crc, uint8_t *out, const uint8_t *in, size_t len)
+      {
+        const uint32_t (*t)[256]= slicing_tables.table;
+
+        for(; len >= 8; len-=8, in+=8) {
+          uint32_t hi= crc ^ load_be32(in);
+          uint32_t lo= load_be32(in + 4);
+
+          crc= t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xff]
+            ^ t[5][(hi >> 8) & 0xff] ^ t[4][hi & 0xff]
+            ^ t[3][lo >> 24] ^ t[2][(lo >> 16) & 0xff]
+            ^ t[1][(lo >> 8) & 0xff] ^ t[0][lo & 0xff];
+
+          if(copy) {
+            memcpy(out, in, 8);
+            out+= 8;
+          }
+        }
+
+        for(; len; len--, in++) {
+          crc= (crc << 8) ^ t[0][(crc >> 24) ^ *in];
+
+          if(copy) {
+            *(out++)= *in;
+          }
+        }
+
+        return crc;
+      }
+
+#ifdef HO_CRC32_HAVE_CLMUL
+      /* Reverses the byte order of a block, so that the first
+       * byte in memory holds the highest polynomial coefficients */
+      inline __m128i
+      __attribute__((target("ssse3,pclmul")))
+      byte_swap(__m128i block)
+      {
+        const __m128i order= _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                           7, 6, 5, 4, 3, 2, 1, 0);
+
+        return _mm_shuffle_epi8(block, order);
+      }
+
+      template<bool copy> inline __m128i
+      __attribute__((target("ssse3,pclmul")))
+      load_block(uint8_t *out, const uint8_t *in)
+      {
+        __m128i block= _mm_loadu_si128((const __m128i *)in);
+
+        if(copy) {
+          _mm_storeu_si128((__m128i *)out, block);
+        }
+
+        return byte_swap(block);
+      }
+
+      /* Multiplies acc by the x^n the constants in k
+       * stand for and adds the next block */
+      inline __m128i
+      __attribute__((target("ssse3,pclmul")))
+      fold(__m128i acc, __m128i k, __m128i next)
+      {
+        __m128i lo= _mm_clmulepi64_si128(acc, k, 0x00);
+        __m128i hi= _mm_clmulepi64_si128(acc, k, 0x11);
+
+        return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+      }
+
+      /* Folds the input in 16 byte blocks using carry-less
+       * multiplication, as described in "Fast CRC Computation for
+       * Generic Polynomials Using PCLMULQDQ Instruction" by Gopal et al.
+       * The remaining 128 bit are left to the table lookup.
+       * len has to be a multiple of 16 and at least 64. */
+      template<bool copy> uint32_t
+      __attribute__((target("ssse3,pclmul")))
+      update_clmul(uint32_t crc, uint8_t *out, const uint8_t *in, size_t len)
+      {
+        // (x^(512+64) mod P, x^512 mod P) and (x^(128+64) mod P, x^128 mod P)
+        const __m128i k_fold4= _mm_set_epi64x(0x8833794c, 0xe6228b11);
+        const __m128i k_fold1= _mm_set_epi64x(0xc5b9cd4c, 0xe8a45605);
+
+        __m128i x1= load_block<copy>(out + 0x00, in + 0x00);
+        __m128i x2= load_block<copy>(out + 0x10, in + 0x10);
+        __m128i x3= load_block<copy>(out + 0x20, in + 0x20);
+        __m128i x4= load_block<copy>(out + 0x30, in + 0x30);
+
+        // The CRC so far is added to the first 32 bits
+        x1= _mm_xor_si128(x1, _mm_set_epi32(crc, 0, 0, 0));
+
+        in+= 64;
+        out+= copy ? 64 : 0;
+        len-= 64;
+
+        // Four independent folding chains, 64 bytes per iteration
+        for(; len >= 64; len-=64, in+=64) {
+          x1= fold(x1, k_fold4, load_block<copy>(out + 0x00, in + 0x00));
+          x2= fold(x2, k_fold4, load_block<copy>(out + 0x10, in + 0x10));
+          x3= fold(x3, k_fold4, load_block<copy>(out + 0x20, in + 0x20));
+          x4= fold(x4, k_fold4, load_block<copy>(out + 0x30, in + 0x30));
+
+          out+= copy ? 64 : 0;
+        }
+
+        // Merge the chains into one
+        x1= fold(x1, k_fold1, x2);
+        x1= fold(x1, k_fold1, x3);
+        x1= fold(x1, k_fold1, x4);
+
+        for(; len >= 16; len-=16, in+=16) {
+          x1= fold(x1, k_fold1, load_block<copy>(out, in));
+
+          out+= copy ? 16 : 0;
+        }
+
+        /* The CRC of the input is the CRC of the 128 bit
+         * remainder, starting from zero */
+        uint8_t remainder[16];
+        _mm_storeu_si128((__m128i *)remainder, byte_swap(x1));
+
+        return update_slicing<false>(0, NULL, remainder, sizeof(remainder));
+      }
+
+      bool
+      cpu_has_clmul()
+      {
+        __builtin_cpu_init();
+
+        return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+      }
+
+      const bool have_clmul= cpu_has_clmul();
+#endif
+
+      template<bool copy> uint32_t
+      crc32(uint8_t *out, const uint8_t *in, size_t len)
+      {
+        uint32_t crc= 0xffffffff;
+
+#ifdef HO_CRC32_HAVE_CLMUL
+        /* The setup and final reduction only pay off
+         * for longer inputs */
+        if(have_clmul && (len >= 64)) {
+          size_t len_clmul= len & ~(size_t)15;
+
+          crc= update_clmul<copy>(crc, out, in, len_clmul);
+
+          in+= len_clmul;
+          out+= copy ? len_clmul : 0;
+          len-= len_clmul;
+        }
+#endif
+
+        crc= update_slicing<copy>(crc, out, in, len);
+
+        return crc ^ 0xffffffff;
+      }
+    }
+
+    uint32_t
+    ho_crc32(const uint8_t *in, size_t len)
+    {
+      return crc32<false>(NULL, in, len);
+    }
+
+    uint32_t
+    ho_crc32_copy(uint8_t *out, const uint8_t *in, size_t len)
+    {
+      return crc32<true>(out, in, len);
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,43 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_CRC32_H
+#define INCLUDED_HNEZ_OFDM_HO_CRC32_H
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* The same CRC-32 gr::digital::crc32 calculates
+     * (polynomial 0x04c11db7, MSB first, inverted).
+     * Uses carry-less multiplication on CPUs that support it
+     * and a slicing-by-8 table lookup otherwise. */
+    uint32_t ho_crc32(const uint8_t *in, size_t len);
+
+    /* Same as ho_crc32 but also copies in to out
+     * while the data is read anyways */
+    uint32_t ho_crc32_copy(uint8_t *out, const uint8_t *in, size_t len);
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_CRC32_H */
@@ -0,0 +1,136 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ho_extract_carriers_impl.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_extract_carriers::sptr
+    ho_extract_carriers::make(int num_carriers, int fft_len, bool contiguous,
+                              const std::vector<int> &pilot_carriers)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_extract_carriers_impl(num_carriers, fft_len, contiguous, pilot_carriers));
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_extract_carriers_impl::ho_extract_carriers_impl(int num_carriers, int fft_len, bool contiguous,
+                                                       const std::vector<int> &pilot_carriers)
+      : gr::block("ho_extract_carriers",
+                  gr::io_signature::make(1, 1, sizeof(gr_complex) * fft_len),
+                  gr::io_signature::make(1, 1, sizeof(gr_complex) * num_carriers)),
+        equalizer(num_carriers, fft_len, contiguous, pilot_carriers, true)
+    {
+      this->num_carriers= num_carriers;
+      this->fft_len= fft_len;
+
+      state= WAIT_FRAME;
+
+      /* Tags are moved from the preamble to the payload by hand */
+      set_tag_propagation_policy(TPP_DONT);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_extract_carriers_impl::~ho_extract_carriers_impl()
+    {
+    }
+
+    void
+    ho_extract_carriers_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
+    {
+      ninput_items_required[0] = noutput_items;
+    }
+
+    int
+    ho_extract_carriers_impl::general_work (int noutput_items,
+                                            gr_vector_int &ninput_items,
+                                            gr_vector_const_void_star &input_items,
+                                            gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+
+      uint64_t start= nitems_read(0);
+
+      std::vector<tag_t> frame_starts;
+      get_tags_in_range(frame_starts, 0, start, start + ninput_items[0],
+                        pmt::mp("frame_id"));
+
+      size_t next_start= 0;
+      int idx_in= 0;
+      int idx_out= 0;
+
+      for(; idx_in < ninput_items[0]; idx_in++) {
+        const gr_complex *in_sym= &in[idx_in * fft_len];
+
+        if((next_start < frame_starts.size())
+           && (frame_starts[next_start].offset == start + idx_in)) {
+
+          get_tags_in_range(frame_tags, 0, start + idx_in, start + idx_in + 1);
+
+          next_start++;
+          state= WAIT_PREAMBLE_B;
+          continue;
+        }
+
+        if(state == WAIT_PREAMBLE_B) {
+          equalizer.estimate(in_sym);
+
+          state= PAYLOAD;
+          continue;
+        }
+
+        if(state != PAYLOAD) {
+          continue;
+        }
+
+        if(idx_out >= noutput_items) {
+          break;
+        }
+
+        equalizer.equalize(in_sym, &out[idx_out * num_carriers]);
+
+        for(size_t i=0; i<frame_tags.size(); i++) {
+          add_item_tag(0, nitems_written(0) + idx_out,
+                       frame_tags[i].key, frame_tags[i].value,
+                       frame_tags[i].srcid);
+        }
+
+        frame_tags.clear();
+
+        idx_out++;
+      }
+
+      consume_each (idx_in);
+      return idx_out;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
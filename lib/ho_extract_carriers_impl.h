@@ -0,0 +1,64 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_EXTRACT_CARRIERS_IMPL_H
+#define INCLUDED_HNEZ_OFDM_HO_EXTRACT_CARRIERS_IMPL_H
+
+#include <hnez_ofdm/ho_extract_carriers.h>
+#include "ho_carrier_equalizer.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    class ho_extract_carriers_impl : public ho_extract_carriers
+    {
+    private:
+      int num_carriers;
+      int fft_len;
+
+      ho_carrier_equalizer equalizer;
+
+      enum {
+        WAIT_FRAME,
+        WAIT_PREAMBLE_B,
+        PAYLOAD
+      } state;
+
+      /* The tags of the current frame that are not
+       * yet copied to the output stream */
+      std::vector<tag_t> frame_tags;
+
+    public:
+      ho_extract_carriers_impl(int num_carriers, int fft_len, bool contiguous,
+                               const std::vector<int> &pilot_carriers);
+      ~ho_extract_carriers_impl();
+
+      void forecast (int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_EXTRACT_CARRIERS_IMPL_H */
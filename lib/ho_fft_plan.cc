@@ -0,0 +1,112 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/fft/fft.h>
+#include <boost/weak_ptr.hpp>
+#include <map>
+#include <stdexcept>
+#include "ho_fft_plan.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_fft_plan::ho_fft_plan(int fft_len, bool forward)
+      : d_fft_len(fft_len)
+    {
+      /* The FFTW planner is not thread safe. Share the lock
+       * with the stock GNU Radio FFT blocks, as they might
+       * be planning at the same time */
+      gr::thread::scoped_lock lock(gr::fft::planner::mutex());
+
+      fftwf_complex *buf= (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex) * fft_len);
+
+      if(!buf) {
+        throw std::runtime_error("ho_fft_plan: failed to allocate planning buffer");
+      }
+
+      int sign= forward ? FFTW_FORWARD : FFTW_BACKWARD;
+
+      d_plan_aligned= fftwf_plan_dft_1d(fft_len, buf, buf, sign,
+                                        FFTW_MEASURE);
+
+      d_plan_unaligned= fftwf_plan_dft_1d(fft_len, buf, buf, sign,
+                                          FFTW_MEASURE | FFTW_UNALIGNED);
+
+      fftwf_free(buf);
+
+      if(!d_plan_aligned || !d_plan_unaligned) {
+        throw std::runtime_error("ho_fft_plan: FFTW failed to create a plan");
+      }
+    }
+
+    ho_fft_plan::~ho_fft_plan()
+    {
+      gr::thread::scoped_lock lock(gr::fft::planner::mutex());
+
+      fftwf_destroy_plan(d_plan_aligned);
+      fftwf_destroy_plan(d_plan_unaligned);
+    }
+
+    ho_fft_plan::sptr
+    ho_fft_plan::get(int fft_len, bool forward)
+    {
+      typedef std::pair<int, bool> key_t;
+
+      static gr::thread::mutex cache_mutex;
+      static std::map<key_t, boost::weak_ptr<ho_fft_plan> > cache;
+
+      gr::thread::scoped_lock lock(cache_mutex);
+
+      /* Plans are only kept alive by the blocks using them,
+       * a plan that is no longer used will be re-created
+       * on the next request */
+      boost::weak_ptr<ho_fft_plan> &cached= cache[key_t(fft_len, forward)];
+      sptr plan= cached.lock();
+
+      if(!plan) {
+        plan.reset(new ho_fft_plan(fft_len, forward));
+        cached= plan;
+      }
+
+      return plan;
+    }
+
+    void
+    ho_fft_plan::execute(gr_complex *buf) const
+    {
+      fftwf_complex *fbuf= reinterpret_cast<fftwf_complex *>(buf);
+
+      /* fftwf_malloc returns maximally aligned memory,
+       * so the aligned plan fits every buffer with an
+       * alignment offset of zero */
+      if(fftwf_alignment_of(reinterpret_cast<float *>(buf)) == 0) {
+        fftwf_execute_dft(d_plan_aligned, fbuf, fbuf);
+      }
+      else {
+        fftwf_execute_dft(d_plan_unaligned, fbuf, fbuf);
+      }
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_FFT_PLAN_H
+#define INCLUDED_HNEZ_OFDM_HO_FFT_PLAN_H
+
+#include <gnuradio/gr_complex.h>
+#include <boost/shared_ptr.hpp>
+#include <fftw3.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* An in-place FFTW plan of a fixed length and direction.
+     * Planning is expensive, so plans are shared between
+     * all blocks of a process that use the same parameters.
+     * Use get() to obtain one. */
+    class ho_fft_plan
+    {
+    private:
+      const int d_fft_len;
+
+      /* FFTW plans may only be executed on arrays with the
+       * same alignment as the ones they were planned for.
+       * Buffers that are not SIMD aligned use the
+       * (slower) unaligned plan. */
+      fftwf_plan d_plan_aligned;
+      fftwf_plan d_plan_unaligned;
+
+      ho_fft_plan(int fft_len, bool forward);
+
+    public:
+      typedef boost::shared_ptr<ho_fft_plan> sptr;
+
+      ~ho_fft_plan();
+
+      /* Return the (possibly cached) plan for the given parameters.
+       * forward selects exp(-j...) (receive side) over
+       * exp(+j...) (transmit side). Neither direction is scaled. */
+      static sptr get(int fft_len, bool forward);
+
+      int fft_len() const { return d_fft_len; }
+
+      /* Transform the fft_len samples at buf in place.
+       * Safe to call from multiple threads at once. */
+      void execute(gr_complex *buf) const;
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_FFT_PLAN_H */
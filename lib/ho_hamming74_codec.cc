@@ -0,0 +1,141 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "ho_hamming74_codec.h"
+#include "ho_hamming74_luts.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_hamming74_codec::ho_hamming74_codec()
+    {
+      for(int byte=0; byte<256; byte++) {
+        lut_encode_byte[byte]= lut_encode[byte & 0x0f] | (lut_encode[byte >> 4] << 7);
+      }
+    }
+
+    int
+    ho_hamming74_codec::encoded_len(int in_len)
+    {
+      // Every input byte becomes two seven bit codewords
+      return (in_len * 14 + 7) / 8;
+    }
+
+    int
+    ho_hamming74_codec::decoded_len(int in_len)
+    {
+      // A partial codeword at the end is zero padded
+      int codewords= (in_len * 8 + 6) / 7;
+
+      return (codewords + 1) / 2;
+    }
+
+    int
+    ho_hamming74_codec::encode(const uint8_t *in, uint8_t *out, int in_len) const
+    {
+      int idx_in=0, idx_out=0;
+
+      /* Four input bytes are eight codewords or 56 bits,
+       * which fills exactly seven output bytes.
+       * The bits are packed LSB first, like repack_bits_bb does */
+      for(; (idx_in + 4) <= in_len; idx_in+=4, idx_out+=7) {
+        uint64_t bits= 0;
+
+        for(int i=0; i<4; i++) {
+          bits|= (uint64_t)lut_encode_byte[in[idx_in + i]] << (14 * i);
+        }
+
+        for(int i=0; i<7; i++) {
+          out[idx_out + i]= bits >> (8 * i);
+        }
+      }
+
+      // Up to three bytes remain, the last output byte is zero padded
+      uint64_t bits= 0;
+      int num_bits= 0;
+
+      for(; idx_in < in_len; idx_in++, num_bits+=14) {
+        bits|= (uint64_t)lut_encode_byte[in[idx_in]] << num_bits;
+      }
+
+      for(; num_bits > 0; num_bits-=8, idx_out++) {
+        out[idx_out]= bits;
+        bits>>= 8;
+      }
+
+      return idx_out;
+    }
+
+    int
+    ho_hamming74_codec::decode(const uint8_t *in, uint8_t *out, int in_len) const
+    {
+      int idx_in=0, idx_out=0;
+
+      /* Seven input bytes contain eight codewords,
+       * which decode to four output bytes */
+      for(; (idx_in + 7) <= in_len; idx_in+=7, idx_out+=4) {
+        uint64_t bits= 0;
+
+        for(int i=0; i<7; i++) {
+          bits|= (uint64_t)in[idx_in + i] << (8 * i);
+        }
+
+        for(int i=0; i<4; i++) {
+          out[idx_out + i]= lut_decode[(bits >> (14 * i)) & 0x7f]
+            | (lut_decode[(bits >> (14 * i + 7)) & 0x7f] << 4);
+        }
+      }
+
+      /* Up to six bytes remain. A partial codeword at the end is
+       * padded with zeros and decoded like a complete one.
+       * When the number of codewords is odd the upper nibble
+       * of the last output byte is zero */
+      uint64_t bits= 0;
+      int num_bits= 0;
+
+      for(; idx_in < in_len; idx_in++, num_bits+=8) {
+        bits|= (uint64_t)in[idx_in] << num_bits;
+      }
+
+      for(int nibble=0; num_bits > 0; nibble++, num_bits-=7) {
+        uint8_t data= lut_decode[bits & 0x7f];
+        bits>>= 7;
+
+        if(nibble % 2) {
+          out[idx_out++]|= data << 4;
+        }
+        else {
+          out[idx_out]= data;
+
+          if(num_bits <= 7) {
+            idx_out++;
+          }
+        }
+      }
+
+      return idx_out;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
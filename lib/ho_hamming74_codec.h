@@ -0,0 +1,56 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_HAMMING74_CODEC_H
+#define INCLUDED_HNEZ_OFDM_HO_HAMMING74_CODEC_H
+
+#include <stdint.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Hamming(7,4) coding of packed bytes.
+     * Every byte is coded as two seven bit codewords,
+     * low nibble first, and the codewords are packed
+     * LSB first without gaps.
+     * This gives the same result as the repack_bits_bb based
+     * chain the module used to have. */
+    class ho_hamming74_codec
+    {
+    private:
+      /* The codewords of both nibbles of a byte,
+       * low nibble in the lower seven bits */
+      uint16_t lut_encode_byte[256];
+
+    public:
+      ho_hamming74_codec();
+
+      // Number of bytes that encode() and decode() output for in_len bytes
+      static int encoded_len(int in_len);
+      static int decoded_len(int in_len);
+
+      int encode(const uint8_t *in, uint8_t *out, int in_len) const;
+      int decode(const uint8_t *in, uint8_t *out, int in_len) const;
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_HAMMING74_CODEC_H */
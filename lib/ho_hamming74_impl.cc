@@ -24,30 +24,7 @@
 
 #include <gnuradio/io_signature.h>
 #include "ho_hamming74_impl.h"
-
-const uint8_t lut_decode[] = {
-  0x00, 0x00, 0x00, 0x03, 0x00, 0x05, 0x0E, 0x07,
-  0x00, 0x09, 0x0E, 0x0B, 0x0E, 0x0D, 0x0E, 0x0E,
-  0x00, 0x03, 0x03, 0x03, 0x04, 0x0D, 0x06, 0x03,
-  0x08, 0x0D, 0x0A, 0x03, 0x0D, 0x0D, 0x0E, 0x0D,
-  0x00, 0x05, 0x02, 0x0B, 0x05, 0x05, 0x06, 0x05,
-  0x08, 0x0B, 0x0B, 0x0B, 0x0C, 0x05, 0x0E, 0x0B,
-  0x08, 0x01, 0x06, 0x03, 0x06, 0x05, 0x06, 0x06,
-  0x08, 0x08, 0x08, 0x0B, 0x08, 0x0D, 0x06, 0x0F,
-  0x00, 0x09, 0x02, 0x07, 0x04, 0x07, 0x07, 0x07,
-  0x09, 0x09, 0x0A, 0x09, 0x0C, 0x09, 0x0E, 0x07,
-  0x04, 0x01, 0x0A, 0x03, 0x04, 0x04, 0x04, 0x07,
-  0x0A, 0x09, 0x0A, 0x0A, 0x04, 0x0D, 0x0A, 0x0F,
-  0x02, 0x01, 0x02, 0x02, 0x0C, 0x05, 0x02, 0x07,
-  0x0C, 0x09, 0x02, 0x0B, 0x0C, 0x0C, 0x0C, 0x0F,
-  0x01, 0x01, 0x02, 0x01, 0x04, 0x01, 0x06, 0x0F,
-  0x08, 0x01, 0x0A, 0x0F, 0x0C, 0x0F, 0x0F, 0x0F
-};
-
-const uint8_t lut_encode[] = {
-  0x00, 0x71, 0x62, 0x13, 0x54, 0x25, 0x36, 0x47,
-  0x38, 0x49, 0x5A, 0x2B, 0x6C, 0x1D, 0x0E, 0x7F
-};
+#include "ho_hamming74_luts.h"
 
 namespace gr {
   namespace hnez_ofdm {
@@ -22,11 +22,12 @@
 #define INCLUDED_HNEZ_OFDM_HO_HAMMING74_IMPL_H
 
 #include <hnez_ofdm/ho_hamming74.h>
+#include "ho_packet_batch_block.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
-    class ho_hamming74_impl : public ho_hamming74
+    class ho_hamming74_impl : public ho_packet_batch_block<ho_hamming74>
     {
     private:
       bool do_encode;
@@ -0,0 +1,55 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_HAMMING74_LUTS_H
+#define INCLUDED_HNEZ_OFDM_HO_HAMMING74_LUTS_H
+
+#include <stdint.h>
+
+/* Hamming(7,4) code tables shared by the hamming blocks.
+ * lut_encode maps a data nibble to its 7 bit codeword,
+ * lut_decode maps a (possibly corrupted) 7 bit codeword
+ * to the data nibble of the closest valid codeword. */
+
+static const uint8_t lut_decode[] = {
+  0x00, 0x00, 0x00, 0x03, 0x00, 0x05, 0x0E, 0x07,
+  0x00, 0x09, 0x0E, 0x0B, 0x0E, 0x0D, 0x0E, 0x0E,
+  0x00, 0x03, 0x03, 0x03, 0x04, 0x0D, 0x06, 0x03,
+  0x08, 0x0D, 0x0A, 0x03, 0x0D, 0x0D, 0x0E, 0x0D,
+  0x00, 0x05, 0x02, 0x0B, 0x05, 0x05, 0x06, 0x05,
+  0x08, 0x0B, 0x0B, 0x0B, 0x0C, 0x05, 0x0E, 0x0B,
+  0x08, 0x01, 0x06, 0x03, 0x06, 0x05, 0x06, 0x06,
+  0x08, 0x08, 0x08, 0x0B, 0x08, 0x0D, 0x06, 0x0F,
+  0x00, 0x09, 0x02, 0x07, 0x04, 0x07, 0x07, 0x07,
+  0x09, 0x09, 0x0A, 0x09, 0x0C, 0x09, 0x0E, 0x07,
+  0x04, 0x01, 0x0A, 0x03, 0x04, 0x04, 0x04, 0x07,
+  0x0A, 0x09, 0x0A, 0x0A, 0x04, 0x0D, 0x0A, 0x0F,
+  0x02, 0x01, 0x02, 0x02, 0x0C, 0x05, 0x02, 0x07,
+  0x0C, 0x09, 0x02, 0x0B, 0x0C, 0x0C, 0x0C, 0x0F,
+  0x01, 0x01, 0x02, 0x01, 0x04, 0x01, 0x06, 0x0F,
+  0x08, 0x01, 0x0A, 0x0F, 0x0C, 0x0F, 0x0F, 0x0F
+};
+
+static const uint8_t lut_encode[] = {
+  0x00, 0x71, 0x62, 0x13, 0x54, 0x25, 0x36, 0x47,
+  0x38, 0x49, 0x5A, 0x2B, 0x6C, 0x1D, 0x0E, 0x7F
+};
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_HAMMING74_LUTS_H */
@@ -0,0 +1,88 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ho_hamming74_packed_impl.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_hamming74_packed::sptr
+    ho_hamming74_packed::make(bool encode, const std::string& len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_hamming74_packed_impl(encode, len_tag_key));
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_hamming74_packed_impl::ho_hamming74_packed_impl(bool encode, const std::string& len_tag_key)
+      : gr::tagged_stream_block("ho_hamming74_packed",
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                len_tag_key)
+    {
+      do_encode= encode;
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_hamming74_packed_impl::~ho_hamming74_packed_impl()
+    {
+    }
+
+    int
+    ho_hamming74_packed_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      if(do_encode) {
+        return ho_hamming74_codec::encoded_len(ninput_items[0]);
+      }
+      else {
+        return ho_hamming74_codec::decoded_len(ninput_items[0]);
+      }
+    }
+
+    int
+    ho_hamming74_packed_impl::work (int noutput_items,
+                                    gr_vector_int &ninput_items,
+                                    gr_vector_const_void_star &input_items,
+                                    gr_vector_void_star &output_items)
+    {
+      const uint8_t *in = (uint8_t *) input_items[0];
+      uint8_t *out = (uint8_t *) output_items[0];
+
+      int in_count= ninput_items[0];
+
+      if(do_encode) {
+        return codec.encode(in, out, in_count);
+      }
+      else {
+        return codec.decode(in, out, in_count);
+      }
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,135 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ho_hamming74_soft_impl.h"
+#include "ho_hamming74_luts.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_hamming74_soft::sptr
+    ho_hamming74_soft::make(const std::string& len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_hamming74_soft_impl(len_tag_key));
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_hamming74_soft_impl::ho_hamming74_soft_impl(const std::string& len_tag_key)
+      : gr::tagged_stream_block("ho_hamming74_soft",
+                                gr::io_signature::make(1, 1, sizeof(float)),
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                len_tag_key)
+    {
+      for(int bit=0; bit<7; bit++) {
+        for(int nibble=0; nibble<16; nibble++) {
+          codeword_signs[bit][nibble]= ((lut_encode[nibble] >> bit) & 0x01) ? -1.0f : 1.0f;
+        }
+      }
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_hamming74_soft_impl::~ho_hamming74_soft_impl()
+    {
+    }
+
+    int
+    ho_hamming74_soft_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      int codewords= (ninput_items[0] + 6) / 7;
+
+      return (codewords + 1) / 2;
+    }
+
+    uint8_t
+    ho_hamming74_soft_impl::decode_word(const float *llrs)
+    {
+      /* Correlate the LLRs with all 16 codewords at once.
+       * The inner loop is over the codewords, so the compiler
+       * can process it in SIMD registers */
+      float metrics[16]= {0};
+
+      for(int bit=0; bit<7; bit++) {
+        for(int nibble=0; nibble<16; nibble++) {
+          metrics[nibble]+= codeword_signs[bit][nibble] * llrs[bit];
+        }
+      }
+
+      // The codeword with the highest correlation is the most likely one
+      uint8_t best= 0;
+
+      for(int nibble=1; nibble<16; nibble++) {
+        if(metrics[nibble] > metrics[best]) {
+          best= nibble;
+        }
+      }
+
+      return best;
+    }
+
+    int
+    ho_hamming74_soft_impl::work (int noutput_items,
+                                  gr_vector_int &ninput_items,
+                                  gr_vector_const_void_star &input_items,
+                                  gr_vector_void_star &output_items)
+    {
+      const float *in = (const float *) input_items[0];
+      uint8_t *out = (uint8_t *) output_items[0];
+
+      int in_len= ninput_items[0];
+      int codewords= (in_len + 6) / 7;
+
+      /* A partial codeword at the end of a packet is
+       * padded with LLRs of zero, as nothing is known
+       * about the missing bits */
+      float padded[7]= {0};
+
+      for(int idx= in_len - (in_len % 7); idx < in_len; idx++) {
+        padded[idx % 7]= in[idx];
+      }
+
+      for(int word=0; word<codewords; word++) {
+        const float *llrs= ((word * 7 + 7) <= in_len) ? &in[word * 7] : padded;
+
+        uint8_t nibble= decode_word(llrs);
+
+        if(word % 2) {
+          out[word / 2]|= nibble << 4;
+        }
+        else {
+          out[word / 2]= nibble;
+        }
+      }
+
+      // Tell runtime system how many output items we produced.
+      return (codewords + 1) / 2;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
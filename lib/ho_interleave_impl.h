@@ -22,18 +22,16 @@
 #define INCLUDED_HNEZ_OFDM_HO_INTERLEAVE_IMPL_H
 
 #include <hnez_ofdm/ho_interleave.h>
+#include "ho_packet_batch_block.h"
+#include "ho_interleaver.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
-    class ho_interleave_impl : public ho_interleave
+    class ho_interleave_impl : public ho_packet_batch_block<ho_interleave>
     {
     private:
-      int chunk_len;
-      int *permute_map;
-
-      void interleave_chunk(const uint8_t *in, uint8_t *out, int in_len);
-      uint32_t lfsr (uint32_t *state);
+      ho_interleaver interleaver;
 
     protected:
       int calculate_output_stream_length(const gr_vector_int &ninput_items);
@@ -0,0 +1,185 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/thread/thread.h>
+#include <boost/weak_ptr.hpp>
+#include <cstring>
+#include <map>
+#include "ho_interleaver.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_interleaver::gather_map_t
+    ho_interleaver::make_gather_map(int chunk_len, bool encode)
+    {
+      size_t chunk_len_bits= chunk_len * 8;
+
+      std::vector<int> map(chunk_len_bits);
+
+      // Initialize the map with a 1:1 mapping
+      for(size_t i=0; i<chunk_len_bits; i++) {
+        map[i]= i;
+      }
+
+      uint32_t lfsr_state= 1;
+
+      // Scramble the 1:1 mapping
+      for(int it=0; it<32; it++) {
+        for(size_t a=0; a<chunk_len_bits; a++) {
+          // I have no idea what i am doing here
+          size_t b= lfsr(&lfsr_state) % chunk_len_bits;
+
+          int tmp= map[b];
+          map[b]= map[a];
+          map[a]= tmp;
+        }
+      }
+
+      /* The map above describes where each input bit goes to.
+       * Store it inverted, as the index of the input bit that every
+       * output bit is taken from, so that interleave_chunk()
+       * can assemble every output byte in one go.
+       * When decoding the mapping has to be applied backwards,
+       * which in turn means that the map can be used as is. */
+      if(!encode) {
+        return gather_map_t(new std::vector<int>(map));
+      }
+
+      std::vector<int> *gather_map= new std::vector<int>(chunk_len_bits);
+
+      for(size_t i=0; i<chunk_len_bits; i++) {
+        (*gather_map)[map[i]]= i;
+      }
+
+      return gather_map_t(gather_map);
+    }
+
+    ho_interleaver::gather_map_t
+    ho_interleaver::get_gather_map(int chunk_len, bool encode)
+    {
+      typedef std::pair<int, bool> key_t;
+
+      static gr::thread::mutex cache_mutex;
+      static std::map<key_t, boost::weak_ptr<const std::vector<int> > > cache;
+
+      gr::thread::scoped_lock lock(cache_mutex);
+
+      /* Maps are only kept as long as there is an
+       * interleaver using them */
+      boost::weak_ptr<const std::vector<int> > &cached= cache[key_t(chunk_len, encode)];
+      gather_map_t gather_map= cached.lock();
+
+      if(!gather_map) {
+        gather_map= make_gather_map(chunk_len, encode);
+        cached= gather_map;
+      }
+
+      return gather_map;
+    }
+
+    ho_interleaver::ho_interleaver(int chunk_len, bool encode)
+      : chunk_len(chunk_len),
+        gather_map(get_gather_map(chunk_len, encode)),
+        unpacked(chunk_len * 8)
+    {
+      for(int byte=0; byte<256; byte++) {
+        for(int bit=0; bit<8; bit++) {
+          spread_lut[byte][bit]= (byte >> bit) & 0x01;
+        }
+      }
+    }
+
+    int
+    ho_interleaver::padded_len(int in_len) const
+    {
+      /* There has to be a more elegant way to calculate this
+         but i can not think of it right now */
+      int chunks= (in_len / chunk_len) + ((in_len % chunk_len) ? 1 : 0);
+
+      return chunks * chunk_len;
+    }
+
+    void
+    ho_interleaver::interleave_chunk(const uint8_t *in, uint8_t *out, int in_len)
+    {
+      /* Spread the input bits out to one byte per bit.
+       * This is done eight bits at a time using a lookup table.
+       * Bits beyond the end of a short chunk are zero */
+      for(int in_byte_idx=0; in_byte_idx < in_len; in_byte_idx++) {
+        memcpy(&unpacked[in_byte_idx * 8], spread_lut[in[in_byte_idx]], 8);
+      }
+
+      memset(&unpacked[0] + in_len * 8, 0, (chunk_len - in_len) * 8);
+
+      const int *map= &(*gather_map)[0];
+
+      for(int out_byte_idx=0; out_byte_idx < chunk_len; out_byte_idx++) {
+        uint8_t out_byte= 0;
+
+        // Collect the eight bits of this output byte
+        for(int out_bit_in_byte=0; out_bit_in_byte < 8; out_bit_in_byte++) {
+          out_byte|= unpacked[map[out_bit_in_byte]] << out_bit_in_byte;
+        }
+
+        out[out_byte_idx]= out_byte;
+        map+= 8;
+      }
+    }
+
+    int
+    ho_interleaver::interleave(const uint8_t *in, uint8_t *out, int in_len)
+    {
+      int cidx=0;
+
+      for(cidx=0; cidx < in_len; cidx+=chunk_len) {
+        int rem_len= in_len - cidx;
+        int this_len= (rem_len < chunk_len) ? rem_len : chunk_len;
+
+        interleave_chunk(&in[cidx], &out[cidx], this_len);
+      }
+
+      return cidx;
+    }
+
+    uint32_t
+    ho_interleaver::lfsr (uint32_t *state)
+    {
+      uint32_t res= 0;
+
+      for(int i=0; i<32; i++) {
+        uint_fast8_t bit= (*state) & 1;
+
+        (*state)>>= 1;
+
+        if(bit) (*state)^= 0x80000057;
+
+        res= (res << 1) | bit;
+      }
+
+      return res;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
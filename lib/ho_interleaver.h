@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_INTERLEAVER_H
+#define INCLUDED_HNEZ_OFDM_HO_INTERLEAVER_H
+
+#include <boost/shared_ptr.hpp>
+#include <stdint.h>
+#include <vector>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Pseudo-random bit interleaving of chunks of chunk_len bytes,
+     * as done by ho_interleave.
+     * Bits are numbered LSB first within every byte. */
+    class ho_interleaver
+    {
+    private:
+      /* For every output bit: the index of the input bit
+       * it is taken from.
+       * Maps are shared read-only between all interleavers
+       * with the same chunk_len and direction */
+      typedef boost::shared_ptr<const std::vector<int> > gather_map_t;
+
+      static gather_map_t make_gather_map(int chunk_len, bool encode);
+      static gather_map_t get_gather_map(int chunk_len, bool encode);
+
+      int chunk_len;
+      const gather_map_t gather_map;
+
+      /* The input chunk with one byte per bit and
+       * the table used to fill it */
+      std::vector<uint8_t> unpacked;
+      uint8_t spread_lut[256][8];
+
+      static uint32_t lfsr (uint32_t *state);
+
+    public:
+      ho_interleaver(int chunk_len, bool encode);
+
+      // in_len rounded up to whole chunks
+      int padded_len(int in_len) const;
+
+      /* Interleave in_len (at most chunk_len) bytes into
+       * chunk_len bytes at out. A short chunk is zero padded */
+      void interleave_chunk(const uint8_t *in, uint8_t *out, int in_len);
+
+      /* Interleave in_len bytes chunk by chunk,
+       * returns the number of bytes written to out */
+      int interleave(const uint8_t *in, uint8_t *out, int in_len);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_INTERLEAVER_H */
@@ -0,0 +1,270 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <stdexcept>
+#include "ho_ofdm_rx_impl.h"
+#include "ho_crc32.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_ofdm_rx::sptr
+    ho_ofdm_rx::make(int fft_len, int num_carriers, bool contiguous,
+                     const std::vector<int> &pilot_carriers,
+                     int max_payload_len, bool raw_pdus)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_ofdm_rx_impl(fft_len, num_carriers, contiguous,
+                             pilot_carriers, max_payload_len,
+                             raw_pdus));
+    }
+
+    int
+    ho_ofdm_rx_impl::check_num_carriers(int num_carriers)
+    {
+      if((num_carriers <= 0) || (num_carriers % 4)) {
+        throw std::invalid_argument("ho_ofdm_rx: num_carriers has to be a multiple of four");
+      }
+
+      return num_carriers;
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_ofdm_rx_impl::ho_ofdm_rx_impl(int fft_len, int num_carriers, bool contiguous,
+                                     const std::vector<int> &pilot_carriers,
+                                     int max_payload_len, bool raw_pdus)
+      : gr::sync_block("ho_ofdm_rx",
+                       gr::io_signature::make(1, 1, sizeof(gr_complex) * fft_len),
+                       gr::io_signature::make(0, 0, 0)),
+        fft_plan(ho_fft_plan::get(fft_len, true)),
+        equalizer(num_carriers, fft_len, contiguous, pilot_carriers, false),
+        deinterleaver(check_num_carriers(num_carriers) / 4, false)
+    {
+      this->fft_len= fft_len;
+      this->num_carriers= num_carriers;
+      this->max_payload_len= max_payload_len;
+      this->raw_pdus= raw_pdus;
+      this->chunk_len= num_carriers / 4;
+
+      state= WAIT_FRAME;
+
+      spectrum= (gr_complex *)volk_malloc(sizeof(gr_complex) * fft_len,
+                                          volk_get_alignment());
+
+      carriers.resize(num_carriers);
+      chunk.resize(chunk_len);
+
+      message_port_register_out(pmt::mp("pdus"));
+      message_port_register_out(pmt::mp("frame_ack"));
+      message_port_register_out(pmt::mp("raw_pdus"));
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_ofdm_rx_impl::~ho_ofdm_rx_impl()
+    {
+      volk_free(spectrum);
+    }
+
+    void
+    ho_ofdm_rx_impl::start_frame(uint64_t offset)
+    {
+      std::vector<tag_t> tags;
+      get_tags_in_range(tags, 0, offset, offset + 1);
+
+      frame.id= 0;
+      frame.meta= pmt::make_dict();
+      frame.symbols_received= 0;
+      frame.symbols_total= 0;
+
+      for(size_t i=0; i<tags.size(); i++) {
+        frame.meta= pmt::dict_add(frame.meta, tags[i].key, tags[i].value);
+
+        if(pmt::eqv(tags[i].key, pmt::mp("frame_id"))) {
+          frame.id= pmt::to_uint64(tags[i].value);
+        }
+      }
+
+      coded.clear();
+      state= WAIT_PREAMBLE_B;
+    }
+
+    void
+    ho_ofdm_rx_impl::send_ack(int num_symbols)
+    {
+      /* The gate counts the preamble symbols as
+       * part of the frame */
+      message_port_pub(pmt::mp("frame_ack"),
+                       pmt::cons(pmt::from_uint64(frame.id),
+                                 pmt::from_long(num_symbols + 2)));
+    }
+
+    void
+    ho_ofdm_rx_impl::parse_header()
+    {
+      // The eight header bytes are coded into the first 14 bytes
+      uint8_t header[8];
+      codec.decode(&coded[0], header, 14);
+
+      frame.payload_len= ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16)
+        | ((uint32_t)header[2] << 8) | header[3];
+
+      frame.crc= ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16)
+        | ((uint32_t)header[6] << 8) | header[7];
+
+      if(frame.payload_len > (uint32_t)max_payload_len) {
+        // Most likely a false detection, stop the gate right away
+        send_ack(frame.symbols_received);
+        state= WAIT_FRAME;
+
+        return;
+      }
+
+      int coded_len= ho_hamming74_codec::encoded_len(frame.payload_len + 8);
+
+      frame.symbols_total= deinterleaver.padded_len(coded_len) / chunk_len;
+
+      send_ack(frame.symbols_total);
+    }
+
+    void
+    ho_ofdm_rx_impl::finish_frame()
+    {
+      int coded_len= ho_hamming74_codec::encoded_len(frame.payload_len + 8);
+
+      decoded.resize(ho_hamming74_codec::decoded_len(coded_len));
+      codec.decode(&coded[0], &decoded[0], coded_len);
+
+      const uint8_t *payload= &decoded[8];
+
+      bool crc_ok= (ho_crc32(payload, frame.payload_len) == frame.crc);
+
+      if(crc_ok || raw_pdus) {
+        pmt::pmt_t vec= pmt::init_u8vector(frame.payload_len, payload);
+
+        if(crc_ok) {
+          message_port_pub(pmt::mp("pdus"), pmt::cons(frame.meta, vec));
+        }
+
+        if(raw_pdus) {
+          pmt::pmt_t meta= pmt::dict_add(frame.meta, pmt::mp("crc_ok"),
+                                         pmt::from_bool(crc_ok));
+
+          message_port_pub(pmt::mp("raw_pdus"), pmt::cons(meta, vec));
+        }
+      }
+
+      state= WAIT_FRAME;
+    }
+
+    void
+    ho_ofdm_rx_impl::process_symbol(const gr_complex *in_sym)
+    {
+      memcpy(spectrum, in_sym, sizeof(gr_complex) * fft_len);
+      fft_plan->execute(spectrum);
+
+      if(state == WAIT_PREAMBLE_B) {
+        equalizer.estimate(spectrum);
+        state= PAYLOAD;
+
+        return;
+      }
+
+      equalizer.equalize(spectrum, &carriers[0]);
+
+      /* Hard QPSK decisions, four symbols per byte, MSB first.
+       * A negative real part is the upper bit of a symbol,
+       * a negative imaginary part the lower one */
+      for(int byte_idx=0; byte_idx < chunk_len; byte_idx++) {
+        const gr_complex *sym= &carriers[byte_idx * 4];
+        uint8_t byte= 0;
+
+        for(int i=0; i<4; i++) {
+          byte= (byte << 2) | ((sym[i].real() < 0) << 1) | (sym[i].imag() < 0);
+        }
+
+        chunk[byte_idx]= byte;
+      }
+
+      size_t chunk_start= coded.size();
+
+      coded.resize(chunk_start + chunk_len);
+      deinterleaver.interleave_chunk(&chunk[0], &coded[chunk_start], chunk_len);
+
+      frame.symbols_received++;
+
+      if((frame.symbols_total == 0) && (coded.size() >= 14)) {
+        parse_header();
+      }
+
+      if((state == PAYLOAD) && (frame.symbols_received == frame.symbols_total)) {
+        finish_frame();
+      }
+    }
+
+    int
+    ho_ofdm_rx_impl::work(int noutput_items,
+                          gr_vector_const_void_star &input_items,
+                          gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+
+      uint64_t start= nitems_read(0);
+
+      std::vector<tag_t> frame_starts;
+      get_tags_in_range(frame_starts, 0, start, start + noutput_items,
+                        pmt::mp("frame_id"));
+
+      size_t next_start= 0;
+
+      for(int idx=0; idx < noutput_items; idx++) {
+        if((next_start < frame_starts.size())
+           && (frame_starts[next_start].offset == start + idx)) {
+
+          /* The first preamble symbol carries nothing
+           * the receiver needs */
+          start_frame(start + idx);
+          next_start++;
+
+          continue;
+        }
+
+        /* Symbols after the end of a frame (until the gate
+         * has seen the ack) and outside of frames are skipped */
+        if(state != WAIT_FRAME) {
+          process_symbol(&in[idx * fft_len]);
+        }
+      }
+
+      // Tell runtime system how many output items we produced.
+      return noutput_items;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,98 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_OFDM_RX_IMPL_H
+#define INCLUDED_HNEZ_OFDM_HO_OFDM_RX_IMPL_H
+
+#include <hnez_ofdm/ho_ofdm_rx.h>
+#include "ho_carrier_equalizer.h"
+#include "ho_fft_plan.h"
+#include "ho_hamming74_codec.h"
+#include "ho_interleaver.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    class ho_ofdm_rx_impl : public ho_ofdm_rx
+    {
+    private:
+      int fft_len;
+      int num_carriers;
+      int max_payload_len;
+      bool raw_pdus;
+
+      // Bytes per interleaver chunk and OFDM symbol
+      int chunk_len;
+
+      const ho_fft_plan::sptr fft_plan;
+      ho_carrier_equalizer equalizer;
+      ho_interleaver deinterleaver;
+      ho_hamming74_codec codec;
+
+      enum {
+        WAIT_FRAME,
+        WAIT_PREAMBLE_B,
+        PAYLOAD
+      } state;
+
+      struct {
+        uint64_t id;
+        pmt::pmt_t meta;
+
+        // Payload symbols received and expected (0 = header not yet decoded)
+        int symbols_received;
+        int symbols_total;
+
+        uint32_t payload_len;
+        uint32_t crc;
+      } frame;
+
+      /* Scratch buffers, the current symbol in its
+       * different stages and the whole coded frame */
+      gr_complex *spectrum;
+      std::vector<gr_complex> carriers;
+      std::vector<uint8_t> chunk;
+      std::vector<uint8_t> coded;
+      std::vector<uint8_t> decoded;
+
+      static int check_num_carriers(int num_carriers);
+
+      void start_frame(uint64_t offset);
+      void send_ack(int num_symbols);
+      void parse_header();
+      void finish_frame();
+      void process_symbol(const gr_complex *in_sym);
+
+    public:
+      ho_ofdm_rx_impl(int fft_len, int num_carriers, bool contiguous,
+                      const std::vector<int> &pilot_carriers,
+                      int max_payload_len, bool raw_pdus);
+      ~ho_ofdm_rx_impl();
+
+      // Where all the action really happens
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_OFDM_RX_IMPL_H */
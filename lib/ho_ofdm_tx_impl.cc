@@ -0,0 +1,212 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include "ho_ofdm_tx_impl.h"
+#include "ho_crc32.h"
+#include "ho_carrier_layout.h"
+#include "ho_qam_constellation.h"
+#include "ho_schmidlcox_preamble.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_ofdm_tx::sptr
+    ho_ofdm_tx::make(int fft_len, int cp_len, int num_carriers,
+                     bool contiguous, const gr_complex &fill,
+                     const std::vector<int> &pilot_carriers,
+                     const std::vector<gr_complex> &pilot_symbols,
+                     int window_len,
+                     const std::string &len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_ofdm_tx_impl(fft_len, cp_len, num_carriers,
+                             contiguous, fill, pilot_carriers, pilot_symbols,
+                             window_len, len_tag_key));
+    }
+
+    int
+    ho_ofdm_tx_impl::check_num_carriers(int num_carriers)
+    {
+      if((num_carriers <= 0) || (num_carriers % 4)) {
+        throw std::invalid_argument("ho_ofdm_tx: num_carriers has to be a multiple of four");
+      }
+
+      return num_carriers;
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_ofdm_tx_impl::ho_ofdm_tx_impl(int fft_len, int cp_len, int num_carriers,
+                                     bool contiguous, const gr_complex &fill,
+                                     const std::vector<int> &pilot_carriers,
+                                     const std::vector<gr_complex> &pilot_symbols,
+                                     int window_len,
+                                     const std::string &len_tag_key)
+      : gr::tagged_stream_block("ho_ofdm_tx",
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                gr::io_signature::make(1, 1, sizeof(gr_complex) * (fft_len + cp_len)),
+                                len_tag_key),
+        interleaver(check_num_carriers(num_carriers) / 4, true),
+        modulator(fft_len, cp_len, true, window_len)
+    {
+      if(pilot_carriers.size() != pilot_symbols.size()) {
+        throw std::invalid_argument("ho_ofdm_tx: need one pilot symbol per pilot carrier");
+      }
+
+      this->fft_len= fft_len;
+      this->cp_len= cp_len;
+      this->num_carriers= num_carriers;
+      this->chunk_len= num_carriers / 4;
+
+      // The same mapping ho_qam4_multimod uses
+      std::vector<gr_complex> constellation= ho_qam_constellation(2);
+
+      for(int byte=0; byte<256; byte++) {
+        for(int sym=0; sym<4; sym++) {
+          symbol_lut[byte][sym]= constellation[(byte >> (6 - 2 * sym)) & 0x03];
+        }
+      }
+
+      // The same symbol layout ho_assign_carriers uses
+      scatter_index= ho_carrier_layout(num_carriers, fft_len,
+                                       contiguous, pilot_carriers);
+
+      symbol_template.assign(fft_len, fill);
+
+      for(size_t i=0; i<pilot_carriers.size(); i++) {
+        symbol_template[pilot_carriers[i]]= pilot_symbols[i];
+      }
+
+      ho_schmidlcox_preamble(fft_len, preamble_a, preamble_b);
+
+      chunk.resize(chunk_len);
+      carriers.resize(num_carriers);
+      spectrum.resize(fft_len);
+
+      /* Every byte is coded into 14 bits or seven QPSK symbols.
+       * Tags other than the packet length are placed
+       * by the scheduler using this rate */
+      set_relative_rate(7.0 / num_carriers);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_ofdm_tx_impl::~ho_ofdm_tx_impl()
+    {
+    }
+
+    int
+    ho_ofdm_tx_impl::coded_len(int payload_len) const
+    {
+      // ho_add_header prepends eight bytes
+      return ho_hamming74_codec::encoded_len(payload_len + 8);
+    }
+
+    int
+    ho_ofdm_tx_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      int num_symbols= interleaver.padded_len(coded_len(ninput_items[0])) / chunk_len;
+
+      // Plus the two preamble symbols
+      return num_symbols + 2;
+    }
+
+    int
+    ho_ofdm_tx_impl::work(int noutput_items,
+                          gr_vector_int &ninput_items,
+                          gr_vector_const_void_star &input_items,
+                          gr_vector_void_star &output_items)
+    {
+      const uint8_t *in = (const uint8_t *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+
+      uint32_t payload_len= ninput_items[0];
+      int out_count= calculate_output_stream_length(ninput_items);
+
+      if(out_count > noutput_items) {
+        throw std::runtime_error("Output buffer to small!");
+      }
+
+      /* The header of ho_add_header: payload length and CRC,
+       * both big endian */
+      uint32_t crc= ho_crc32(in, payload_len);
+      uint8_t header[8];
+
+      header[0]= (payload_len >> 24) & 0xff;
+      header[1]= (payload_len >> 16) & 0xff;
+      header[2]= (payload_len >>  8) & 0xff;
+      header[3]= (payload_len >>  0) & 0xff;
+
+      header[4]= (crc >> 24) & 0xff;
+      header[5]= (crc >> 16) & 0xff;
+      header[6]= (crc >>  8) & 0xff;
+      header[7]= (crc >>  0) & 0xff;
+
+      /* The header codes to exactly 14 bytes, so the payload
+       * can be coded separately without copying it behind the header */
+      coded.resize(coded_len(payload_len));
+
+      int coded_count= codec.encode(header, &coded[0], sizeof(header));
+      coded_count+= codec.encode(in, &coded[coded_count], payload_len);
+
+      const int sym_len= fft_len + cp_len;
+
+      modulator.modulate(&preamble_a[0], &out[0]);
+      modulator.modulate(&preamble_b[0], &out[sym_len]);
+
+      const int *scatter= &scatter_index[0];
+
+      /* Every interleaver chunk fills exactly one OFDM symbol,
+       * so every stage but the coding works on one symbol at a time */
+      for(int sym_idx=0; sym_idx < (out_count - 2); sym_idx++) {
+        int chunk_start= sym_idx * chunk_len;
+        int rem_len= coded_count - chunk_start;
+
+        interleaver.interleave_chunk(&coded[chunk_start], &chunk[0],
+                                     (rem_len < chunk_len) ? rem_len : chunk_len);
+
+        for(int byte_idx=0; byte_idx < chunk_len; byte_idx++) {
+          memcpy(&carriers[byte_idx * 4], symbol_lut[chunk[byte_idx]],
+                 sizeof(symbol_lut[0]));
+        }
+
+        memcpy(&spectrum[0], &symbol_template[0], sizeof(gr_complex) * fft_len);
+
+        for(int ci=0; ci<num_carriers; ci++) {
+          spectrum[scatter[ci]]= carriers[ci];
+        }
+
+        modulator.modulate(&spectrum[0], &out[(sym_idx + 2) * sym_len]);
+      }
+
+      // Tell runtime system how many output items we produced.
+      return out_count;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
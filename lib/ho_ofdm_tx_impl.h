@@ -0,0 +1,85 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_OFDM_TX_IMPL_H
+#define INCLUDED_HNEZ_OFDM_HO_OFDM_TX_IMPL_H
+
+#include <hnez_ofdm/ho_ofdm_tx.h>
+#include "ho_packet_batch_block.h"
+#include "ho_hamming74_codec.h"
+#include "ho_interleaver.h"
+#include "ho_symbol_modulator.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    class ho_ofdm_tx_impl : public ho_packet_batch_block<ho_ofdm_tx>
+    {
+    private:
+      int fft_len;
+      int cp_len;
+      int num_carriers;
+
+      // Bytes per interleaver chunk and OFDM symbol
+      int chunk_len;
+
+      ho_hamming74_codec codec;
+      ho_interleaver interleaver;
+      ho_symbol_modulator modulator;
+
+      gr_complex symbol_lut[256][4];
+      std::vector<int> scatter_index;
+      std::vector<gr_complex> symbol_template;
+      std::vector<gr_complex> preamble_a;
+      std::vector<gr_complex> preamble_b;
+
+      /* Scratch buffers, the coded packet and
+       * the current symbol in its different stages */
+      std::vector<uint8_t> coded;
+      std::vector<uint8_t> chunk;
+      std::vector<gr_complex> carriers;
+      std::vector<gr_complex> spectrum;
+
+      static int check_num_carriers(int num_carriers);
+      int coded_len(int payload_len) const;
+
+    protected:
+      int calculate_output_stream_length(const gr_vector_int &ninput_items);
+
+    public:
+      ho_ofdm_tx_impl(int fft_len, int cp_len, int num_carriers,
+                      bool contiguous, const gr_complex &fill,
+                      const std::vector<int> &pilot_carriers,
+                      const std::vector<gr_complex> &pilot_symbols,
+                      int window_len,
+                      const std::string &len_tag_key);
+      ~ho_ofdm_tx_impl();
+
+      // Where all the action really happens
+      int work(int noutput_items,
+               gr_vector_int &ninput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_OFDM_TX_IMPL_H */
@@ -0,0 +1,184 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_PACKET_BATCH_BLOCK_H
+#define INCLUDED_HNEZ_OFDM_HO_PACKET_BATCH_BLOCK_H
+
+#include <gnuradio/tagged_stream_block.h>
+#include <gnuradio/prefs.h>
+#include <algorithm>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Base for the tagged stream blocks of this module.
+     *
+     * gr::tagged_stream_block calls work() once per packet,
+     * for small packets the scheduler overhead of every call
+     * dominates the actual processing.
+     * This template replaces general_work() by a loop that calls the
+     * unchanged per-packet work() of the block for every complete
+     * packet in the input buffer and writes the length tags itself.
+     *
+     * Like the blocks using it, it only supports one input and one output.
+     * block_t is the public interface class of the block.
+     *
+     * Batching can be turned off with the packet_batching option in
+     * the [hnez_ofdm] section of the GNU Radio config or with
+     * GR_CONF_HNEZ_OFDM_PACKET_BATCHING=False, the block then handles
+     * one packet per call, like gr::tagged_stream_block. */
+    template<class block_t>
+    class ho_packet_batch_block : public block_t
+    {
+    private:
+      const pmt::pmt_t d_len_tag_key;
+      const bool d_batch;
+
+      // Length of a packet that did not completely fit in the last call
+      int d_pending_len;
+
+      std::vector<tag_t> d_len_tags;
+
+    public:
+      ho_packet_batch_block()
+        : d_len_tag_key(pmt::string_to_symbol(this->d_length_tag_key_str)),
+          d_batch(prefs::singleton()->get_bool("hnez_ofdm", "packet_batching", true)),
+          d_pending_len(0)
+      {
+      }
+
+      void
+      forecast(int noutput_items, gr_vector_int &ninput_items_required)
+      {
+        ninput_items_required[0]= std::max(d_pending_len, 1);
+      }
+
+      int
+      general_work(int noutput_items,
+                   gr_vector_int &ninput_items,
+                   gr_vector_const_void_star &input_items,
+                   gr_vector_void_star &output_items)
+      {
+        const size_t in_itemsize= this->input_signature()->sizeof_stream_item(0);
+        const size_t out_itemsize= this->output_signature()->sizeof_stream_item(0);
+
+        const uint8_t *in= (const uint8_t *)input_items[0];
+        uint8_t *out= (uint8_t *)output_items[0];
+
+        const uint64_t read_start= this->nitems_read(0);
+        const uint64_t written_start= this->nitems_written(0);
+
+        /* Without batching only the tag of the first packet is needed */
+        const uint64_t read_end= d_batch ? (read_start + ninput_items[0]) : (read_start + 1);
+
+        this->get_tags_in_range(d_len_tags, 0, read_start, read_end, d_len_tag_key);
+
+        std::stable_sort(d_len_tags.begin(), d_len_tags.end(), tag_t::offset_compare);
+
+        int consumed= 0;
+        int produced= 0;
+
+        gr_vector_int packet_ninput(1);
+        gr_vector_const_void_star packet_in(1);
+        gr_vector_void_star packet_out(1);
+
+        for(size_t tag_idx=0; tag_idx < d_len_tags.size(); tag_idx++) {
+          const tag_t &len_tag= d_len_tags[tag_idx];
+
+          /* Packets follow each other without gaps,
+           * tags inside a packet are ignored like
+           * gr::tagged_stream_block does */
+          if(len_tag.offset < (read_start + consumed)) {
+            continue;
+          }
+
+          if(len_tag.offset > (read_start + consumed)) {
+            break;
+          }
+
+          int packet_len= pmt::to_long(len_tag.value);
+
+          if((consumed + packet_len) > ninput_items[0]) {
+            d_pending_len= packet_len;
+            break;
+          }
+
+          packet_ninput[0]= packet_len;
+          int packet_noutput= this->calculate_output_stream_length(packet_ninput);
+
+          if((produced + packet_noutput) > noutput_items) {
+            if(produced == 0) {
+              this->set_min_noutput_items(packet_noutput);
+            }
+
+            break;
+          }
+
+          packet_in[0]= in + consumed * in_itemsize;
+          packet_out[0]= out + produced * out_itemsize;
+
+          int packet_produced= this->work(packet_noutput, packet_ninput,
+                                          packet_in, packet_out);
+
+          if(packet_produced < 0) {
+            if((consumed == 0) && (produced == 0)) {
+              return packet_produced;
+            }
+
+            break;
+          }
+
+          this->remove_item_tag(0, len_tag);
+
+          /* Blocks may drop a packet by producing nothing,
+           * it then does not get a length tag either */
+          if(packet_produced > 0) {
+            this->add_item_tag(0, written_start + produced,
+                               d_len_tag_key, pmt::from_long(packet_produced));
+          }
+
+          consumed+= packet_len;
+          produced+= packet_produced;
+          d_pending_len= 0;
+
+          if(!d_batch) {
+            break;
+          }
+        }
+
+        if((consumed == 0) && (d_pending_len == 0) && (ninput_items[0] > 0)
+           && (d_len_tags.empty() || (d_len_tags[0].offset > read_start))) {
+
+          throw std::runtime_error("Missing a required length tag on port 0 at item #"
+                                   + std::to_string(read_start));
+        }
+
+        this->consume_each(consumed);
+
+        return produced;
+      }
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_PACKET_BATCH_BLOCK_H */
@@ -24,13 +24,7 @@
 
 #include <gnuradio/io_signature.h>
 #include "ho_qam4_multimod_impl.h"
-
-const gr_complex constellation[]= {
-  gr_complex( M_SQRT1_2,  M_SQRT1_2),
-  gr_complex( M_SQRT1_2, -M_SQRT1_2),
-  gr_complex(-M_SQRT1_2,  M_SQRT1_2),
-  gr_complex(-M_SQRT1_2, -M_SQRT1_2)
-};
+#include "ho_qam_constellation.h"
 
 namespace gr {
   namespace hnez_ofdm {
@@ -46,16 +40,28 @@ namespace gr {
      * The private constructor
      */
     ho_qam4_multimod_impl::ho_qam4_multimod_impl(int output_width, const std::string &len_tag_key)
-      : gr::sync_decimator("ho_qam4_multimod",
-                           gr::io_signature::make(1, 1, sizeof(uint8_t)),
-                           gr::io_signature::make(1, 1, sizeof(gr_complex) * output_width),
-                           output_width/4)
+      : gr::tagged_stream_block("ho_qam4_multimod",
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                gr::io_signature::make(1, 1, sizeof(gr_complex) * output_width),
+                                len_tag_key)
     {
       this->output_width= output_width;
-      this->len_tag_key= pmt::intern(len_tag_key);
+      this->decimation= output_width/4;
+
+      std::vector<gr_complex> constellation= ho_qam_constellation(2);
 
-      // The packet_len tag has to be transformed manually
-      set_tag_propagation_policy(TPP_DONT);
+      /* Every input byte maps to four symbols,
+       * the first one taken from the most significant bits */
+      for(int byte=0; byte<256; byte++) {
+        for(int sym=0; sym<4; sym++) {
+          symbol_lut[byte][sym]= constellation[(byte >> (6 - 2 * sym)) & 0x03];
+        }
+      }
+
+      /* The packet length tags are handled by tagged_stream_block,
+       * the scheduler moves all other tags to the corresponding
+       * output vector using the relative rate */
+      set_relative_rate(1.0 / decimation);
     }
 
     /*
@@ -65,51 +71,39 @@ namespace gr {
     {
     }
 
+    int
+    ho_qam4_multimod_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      // A partial vector at the end of a packet is padded
+      return (ninput_items[0] + decimation - 1) / decimation;
+    }
+
     int
     ho_qam4_multimod_impl::work(int noutput_items,
+                                gr_vector_int &ninput_items,
                                 gr_vector_const_void_star &input_items,
                                 gr_vector_void_star &output_items)
     {
       const uint8_t *in = (const uint8_t *) input_items[0];
       gr_complex *out = (gr_complex *) output_items[0];
 
-      int decimation= output_width/4;
-      int ninput_items= noutput_items * decimation;
+      int in_len= ninput_items[0];
+      int out_len= calculate_output_stream_length(ninput_items);
       int out_idx= 0;
 
-      for(int in_idx=0; in_idx < ninput_items; in_idx++) {
-        uint8_t in_byte= in[in_idx];
-
-        out[out_idx++]= constellation[(in_byte>>6) & 0x03];
-        out[out_idx++]= constellation[(in_byte>>4) & 0x03];
-        out[out_idx++]= constellation[(in_byte>>2) & 0x03];
-        out[out_idx++]= constellation[(in_byte>>0) & 0x03];
+      for(int in_idx=0; in_idx < in_len; in_idx++) {
+        memcpy(&out[out_idx], symbol_lut[in[in_idx]], sizeof(symbol_lut[0]));
+        out_idx+= 4;
       }
 
-      // Manually propagate tags
-      
-      uint64_t absidx_in= nitems_read(0);
-      uint64_t absidx_out= nitems_written(0);
-
-      std::vector<tag_t> tags;
-      get_tags_in_range(tags, 0, absidx_in, absidx_in + ninput_items);
-
-      for(tag_t tag : tags) {
-        tag.offset/= decimation;
-                
-        if(pmt::eqv(tag.key, len_tag_key)) {
-          // Only the packet_len tag has to be mangled
-          
-          int pkg_len_orig= pmt::to_long(tag.value);
-          int pkg_len_new= pkg_len_orig / decimation;
-          tag.value= pmt::from_long(pkg_len_new);
-        }
-
-        add_item_tag(0, tag);
+      // The padding is modulated like zero bytes
+      for(int pad_idx=in_len; pad_idx < (out_len * decimation); pad_idx++) {
+        memcpy(&out[out_idx], symbol_lut[0], sizeof(symbol_lut[0]));
+        out_idx+= 4;
       }
-      
+
       // Tell runtime system how many output items we produced.
-      return noutput_items;
+      return out_len;
     }
 
   } /* namespace hnez_ofdm */
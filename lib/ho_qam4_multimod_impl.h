@@ -22,15 +22,22 @@
 #define INCLUDED_HNEZ_OFDM_HO_QAM4_MULTIMOD_IMPL_H
 
 #include <hnez_ofdm/ho_qam4_multimod.h>
+#include "ho_packet_batch_block.h"
 
 namespace gr {
   namespace hnez_ofdm {
 
-    class ho_qam4_multimod_impl : public ho_qam4_multimod
+    class ho_qam4_multimod_impl : public ho_packet_batch_block<ho_qam4_multimod>
     {
     private:
       int output_width;
-      pmt::pmt_t len_tag_key;
+      int decimation;
+
+      // The four symbols of every input byte
+      gr_complex symbol_lut[256][4];
+
+    protected:
+      int calculate_output_stream_length(const gr_vector_int &ninput_items);
 
     public:
       ho_qam4_multimod_impl(int output_width, const std::string &len_tag_key);
@@ -38,6 +45,7 @@ namespace gr {
 
       // Where all the action really happens
       int work(int noutput_items,
+               gr_vector_int &ninput_items,
                gr_vector_const_void_star &input_items,
                gr_vector_void_star &output_items);
     };
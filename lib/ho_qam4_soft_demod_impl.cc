@@ -0,0 +1,102 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ho_qam4_soft_demod_impl.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_qam4_soft_demod::sptr
+    ho_qam4_soft_demod::make(float noise_var, const std::string& len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_qam4_soft_demod_impl(noise_var, len_tag_key));
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_qam4_soft_demod_impl::ho_qam4_soft_demod_impl(float noise_var, const std::string& len_tag_key)
+      : gr::tagged_stream_block("ho_qam4_soft_demod",
+                                gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                                gr::io_signature::make(1, 1, sizeof(float)),
+                                len_tag_key)
+    {
+      /* Every bit is carried by one axis with an amplitude
+       * of 1/sqrt(2) and half of the noise power, giving
+       * LLR = 2 * (1/sqrt(2)) * x / (noise_var / 2) */
+      llr_scale= 2.0f * M_SQRT2 / noise_var;
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_qam4_soft_demod_impl::~ho_qam4_soft_demod_impl()
+    {
+    }
+
+    int
+    ho_qam4_soft_demod_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      int bytes= (ninput_items[0] + 3) / 4;
+
+      return bytes * 8;
+    }
+
+    int
+    ho_qam4_soft_demod_impl::work (int noutput_items,
+                                   gr_vector_int &ninput_items,
+                                   gr_vector_const_void_star &input_items,
+                                   gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      float *out = (float *) output_items[0];
+
+      int in_len= ninput_items[0];
+      int out_len= calculate_output_stream_length(ninput_items);
+
+      /* Symbol s of a byte carries bit 7-2s on the real and
+       * bit 6-2s on the imaginary axis.
+       * A one is mapped to a negative value, which matches the sign
+       * convention of the LLRs, so no negation is needed */
+      for(int sym_idx=0; sym_idx < in_len; sym_idx++) {
+        float *byte_llrs= &out[(sym_idx / 4) * 8];
+        int bit_hi= 7 - 2 * (sym_idx % 4);
+
+        byte_llrs[bit_hi]= in[sym_idx].real() * llr_scale;
+        byte_llrs[bit_hi - 1]= in[sym_idx].imag() * llr_scale;
+      }
+
+      // Bits of a partial byte at the end of a packet are unknown
+      for(int idx= in_len * 2; idx < out_len; idx++) {
+        out[idx - (idx % 8) + 7 - (idx % 8)]= 0.0f;
+      }
+
+      // Tell runtime system how many output items we produced.
+      return out_len;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
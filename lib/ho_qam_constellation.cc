@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include "ho_qam_constellation.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Map the Gray coded bits of one axis to an amplitude
+     * level out of levels = 2^bits_per_axis possible levels */
+    static float
+    gray_to_level(unsigned gray, int levels)
+    {
+      unsigned binary= gray;
+
+      for(unsigned shift= gray >> 1; shift; shift>>= 1) {
+        binary^= shift;
+      }
+
+      // Binary zero is the largest positive level
+      return (levels - 1) - 2.0f * binary;
+    }
+
+    std::vector<gr_complex>
+    ho_qam_constellation(int bits_per_symbol)
+    {
+      int bits_per_axis= bits_per_symbol / 2;
+      int levels= 1 << bits_per_axis;
+      int points= 1 << bits_per_symbol;
+
+      /* The average power of a square QAM constellation
+       * with unit spaced levels is 2(M-1)/3 */
+      float scale= 1.0f / std::sqrt(2.0f * (points - 1) / 3.0f);
+
+      std::vector<gr_complex> constellation(points);
+
+      for(int sym=0; sym<points; sym++) {
+        unsigned bits_re= sym >> bits_per_axis;
+        unsigned bits_im= sym & (levels - 1);
+
+        constellation[sym]= gr_complex(gray_to_level(bits_re, levels),
+                                       gray_to_level(bits_im, levels)) * scale;
+      }
+
+      return constellation;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,44 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_QAM_CONSTELLATION_H
+#define INCLUDED_HNEZ_OFDM_HO_QAM_CONSTELLATION_H
+
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Return the points of a square, Gray mapped QAM constellation
+     * with 2^bits_per_symbol points, indexed by the symbol value.
+     * The upper half of the bits select the real part,
+     * the lower half the imaginary part.
+     * Within each half the MSB selects the sign (one is negative)
+     * and the remaining bits select the magnitude in Gray code.
+     * The constellation is scaled to an average power of one.
+     * For two bits per symbol this is the QPSK constellation
+     * of ho_qam4_multimod. */
+    std::vector<gr_complex> ho_qam_constellation(int bits_per_symbol);
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_QAM_CONSTELLATION_H */
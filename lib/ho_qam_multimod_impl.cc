@@ -0,0 +1,179 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <algorithm>
+#include "ho_qam_multimod_impl.h"
+#include "ho_qam_constellation.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_qam_multimod::sptr
+    ho_qam_multimod::make(int bits_per_symbol, int output_width,
+                          const std::string &len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_qam_multimod_impl(bits_per_symbol, output_width, len_tag_key));
+    }
+
+    /* The number of input bytes per output vector,
+     * checks the parameters on the way */
+    static int
+    bytes_per_vector(int bits_per_symbol, int output_width)
+    {
+      if((bits_per_symbol != 2) && (bits_per_symbol != 4)
+         && (bits_per_symbol != 6) && (bits_per_symbol != 8)) {
+        throw std::invalid_argument("ho_qam_multimod: bits_per_symbol has to be 2, 4, 6 or 8");
+      }
+
+      // 64-QAM is processed in groups of four symbols (three bytes)
+      int group_len= (bits_per_symbol == 6) ? 4 : (8 / bits_per_symbol);
+
+      if((output_width <= 0) || (output_width % group_len)) {
+        throw std::invalid_argument("ho_qam_multimod: output_width does not fill whole bytes");
+      }
+
+      return (output_width * bits_per_symbol) / 8;
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_qam_multimod_impl::ho_qam_multimod_impl(int bits_per_symbol, int output_width,
+                                               const std::string &len_tag_key)
+      : gr::tagged_stream_block("ho_qam_multimod",
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                gr::io_signature::make(1, 1, sizeof(gr_complex) * output_width),
+                                len_tag_key)
+    {
+      this->bits_per_symbol= bits_per_symbol;
+      this->output_width= output_width;
+      this->decimation= bytes_per_vector(bits_per_symbol, output_width);
+
+      std::vector<gr_complex> constellation= ho_qam_constellation(bits_per_symbol);
+
+      if(bits_per_symbol == 6) {
+        symbols_per_entry= 1;
+        symbol_lut= constellation;
+      }
+      else {
+        /* Look up all symbols of an input byte at once.
+         * The first symbol is taken from the most significant bits */
+        symbols_per_entry= 8 / bits_per_symbol;
+        symbol_lut.resize(256 * symbols_per_entry);
+
+        int sym_mask= (1 << bits_per_symbol) - 1;
+
+        for(int byte=0; byte<256; byte++) {
+          for(int sym=0; sym<symbols_per_entry; sym++) {
+            int shift= 8 - bits_per_symbol * (sym + 1);
+
+            symbol_lut[byte * symbols_per_entry + sym]=
+              constellation[(byte >> shift) & sym_mask];
+          }
+        }
+      }
+
+      /* The packet length tags are handled by tagged_stream_block,
+       * the scheduler moves all other tags to the corresponding
+       * output vector using the relative rate */
+      set_relative_rate(1.0 / decimation);
+
+      padded_vector.resize(decimation);
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_qam_multimod_impl::~ho_qam_multimod_impl()
+    {
+    }
+
+    int
+    ho_qam_multimod_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      // A partial vector at the end of a packet is padded
+      return (ninput_items[0] + decimation - 1) / decimation;
+    }
+
+    void
+    ho_qam_multimod_impl::modulate(const uint8_t *in, gr_complex *out, int in_len)
+    {
+      const gr_complex *lut= &symbol_lut[0];
+
+      if(bits_per_symbol == 6) {
+        // Three bytes contain four 6 bit symbols
+        for(int in_idx=0; in_idx < in_len; in_idx+=3) {
+          uint32_t bits= (in[in_idx] << 16) | (in[in_idx + 1] << 8) | in[in_idx + 2];
+
+          *out++= lut[(bits >> 18) & 0x3f];
+          *out++= lut[(bits >> 12) & 0x3f];
+          *out++= lut[(bits >> 6) & 0x3f];
+          *out++= lut[bits & 0x3f];
+        }
+      }
+      else {
+        size_t entry_size= sizeof(gr_complex) * symbols_per_entry;
+
+        for(int in_idx=0; in_idx < in_len; in_idx++) {
+          memcpy(out, &lut[in[in_idx] * symbols_per_entry], entry_size);
+          out+= symbols_per_entry;
+        }
+      }
+    }
+
+    int
+    ho_qam_multimod_impl::work(int noutput_items,
+                               gr_vector_int &ninput_items,
+                               gr_vector_const_void_star &input_items,
+                               gr_vector_void_star &output_items)
+    {
+      const uint8_t *in = (const uint8_t *) input_items[0];
+      gr_complex *out = (gr_complex *) output_items[0];
+
+      int in_len= ninput_items[0];
+      int out_len= calculate_output_stream_length(ninput_items);
+
+      int full_len= (in_len / decimation) * decimation;
+
+      modulate(in, out, full_len);
+
+      /* A partial vector at the end is padded with zero bytes.
+       * This way 64-QAM never reads beyond a packet */
+      if(full_len < in_len) {
+        std::fill(padded_vector.begin(), padded_vector.end(), 0);
+        std::copy(&in[full_len], &in[in_len], padded_vector.begin());
+
+        modulate(&padded_vector[0], &out[(full_len / decimation) * output_width],
+                 decimation);
+      }
+
+      // Tell runtime system how many output items we produced.
+      return out_len;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
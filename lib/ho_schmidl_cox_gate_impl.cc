@@ -24,13 +24,23 @@
 
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include "ho_schmidl_cox_gate_impl.h"
+#include "ho_schmidlcox_preamble.h"
+#include "ho_symbol_modulator.h"
+
+#ifdef GR_CTRLPORT
+#include <gnuradio/rpcregisterhelpers.h>
+#endif
 
 namespace gr {
   namespace hnez_ofdm {
     ho_schmidl_cox_gate_impl::d_energy_history_t::d_energy_history_t(size_t fft_len)
       : history(new gr_complex[fft_len]),
-        history_len(fft_len)
+        history_len(fft_len),
+        resum_interval(16 * fft_len)
     {
       reset();
     }
@@ -47,9 +57,37 @@ namespace gr {
       acc_ref= 0;
       acc_detect= 0;
 
+      resum_countdown= resum_interval;
+
       ready= false;
     }
 
+    void
+    ho_schmidl_cox_gate_impl::d_energy_history_t::resum()
+    {
+      /* Recalculate both accumulators from the samples
+       * in the history instead of the running sums */
+      size_t half_len= history_len/2;
+
+      acc_ref= 0;
+      acc_detect= 0;
+
+      for(size_t i=0; i<history_len; i++) {
+        acc_ref+= norm(history[i]);
+      }
+
+      /* history_idx points to the oldest sample,
+       * the detection window consists of the newer half */
+      for(size_t i=0; i<half_len; i++) {
+        gr_complex older= history[(history_idx + i) % history_len];
+        gr_complex newer= history[(history_idx + i + half_len) % history_len];
+
+        acc_detect+= newer * conj(older);
+      }
+
+      resum_countdown= resum_interval;
+    }
+
     void
     ho_schmidl_cox_gate_impl::d_energy_history_t::update(gr_complex now)
     {
@@ -74,6 +112,16 @@ namespace gr {
 
       // Signal readieness if the history is filled
       ready= ready || !history_idx;
+
+      /* The accumulators are only ever updated by adding and
+       * subtracting terms, so rounding errors pile up in them and
+       * lead to false or missed detections on long running streams.
+       * Summing them up from scratch once every resum_interval samples
+       * keeps the error bounded for less than one extra operation
+       * per sample. */
+      if(!(--resum_countdown)) {
+        resum();
+      }
     }
 
     gr_complex
@@ -97,25 +145,466 @@ namespace gr {
       }
     }
 
+    ho_schmidl_cox_gate_impl::d_window_metric_t::d_window_metric_t(size_t fft_len,
+                                                                   size_t symbol_len,
+                                                                   int num_threads)
+      : window_len(fft_len),
+        shard_len_min(symbol_len),
+        num_threads(num_threads),
+        chunk_len(symbol_len * ((num_threads > 1) ? (16 * num_threads) : 4)),
+        pool((num_threads > 1) ? new ho_worker_pool(num_threads) : NULL)
+    {
+      size_t alignment= volk_get_alignment();
+
+      ref_terms= (float *)volk_malloc(sizeof(float) * (chunk_len + window_len),
+                                      alignment);
+      det_terms= (gr_complex *)volk_malloc(sizeof(gr_complex) * (chunk_len + window_len/2),
+                                           alignment);
+
+      ref_energy= (float *)volk_malloc(sizeof(float) * chunk_len, alignment);
+      det_energy= (gr_complex *)volk_malloc(sizeof(gr_complex) * chunk_len, alignment);
+      relative_power= (float *)volk_malloc(sizeof(float) * chunk_len, alignment);
+
+      next_idx= 0;
+
+      invalidate(0);
+      reset();
+    }
+
+    ho_schmidl_cox_gate_impl::d_window_metric_t::~d_window_metric_t()
+    {
+      volk_free(ref_terms);
+      volk_free(det_terms);
+      volk_free(ref_energy);
+      volk_free(det_energy);
+      volk_free(relative_power);
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_window_metric_t::reset()
+    {
+      /* Just like d_energy_history_t no values are reported
+       * until window_len new samples were seen */
+      fill= 0;
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_window_metric_t::invalidate(int64_t consumed)
+    {
+      /* The precalculated values refer to positions in the
+       * input buffer. They become useless once the buffer moves. */
+      chunk_start= 0;
+      chunk_end= 0;
+      cur_idx= 0;
+
+      next_idx-= consumed;
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_window_metric_t::calc_terms(const gr_complex *in,
+                                                             int shard, int num_shards)
+    {
+      /* The terms that slide into and out of the windows only depend
+       * on the input samples, so they can be calculated for the whole chunk
+       * at once:
+       *   ref_terms[i]= norm(in[j]),                   j= chunk_start - window_len + i
+       *   det_terms[i]= in[j] * conj(in[j - half_len]), j= chunk_start - half_len + i */
+
+      size_t half_len= window_len/2;
+      size_t len= chunk_end - chunk_start;
+
+      size_t ref_len= len + window_len;
+      size_t ref_from= (ref_len * shard) / num_shards;
+      size_t ref_to= (ref_len * (shard + 1)) / num_shards;
+
+      size_t det_len= len + half_len;
+      size_t det_from= (det_len * shard) / num_shards;
+      size_t det_to= (det_len * (shard + 1)) / num_shards;
+
+      const gr_complex *ref_in= &in[chunk_start - window_len];
+      const gr_complex *det_in= &in[chunk_start - half_len];
+
+      volk_32fc_magnitude_squared_32f(&ref_terms[ref_from],
+                                      &ref_in[ref_from],
+                                      ref_to - ref_from);
+
+      volk_32fc_x2_multiply_conjugate_32fc(&det_terms[det_from],
+                                           &det_in[det_from],
+                                           &ref_in[det_from],
+                                           det_to - det_from);
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_window_metric_t::slide_windows(int shard, int num_shards)
+    {
+      /* The resulting values match those of d_energy_history_t up to
+       * float rounding, as the window sums are calculated from scratch at
+       * the start of every shard instead of being carried along.
+       * This also means that rounding errors can not accumulate
+       * for longer than one shard.
+       * The only other difference is right after a realignment:
+       * d_energy_history_t keeps samples from before the jump in its
+       * ring buffer and starts reporting values for this mixed window
+       * early, update() on the other hand restarts counting the
+       * window fill at the jump. This affects at most fft_len
+       * samples after each detected preamble. */
+
+      size_t half_len= window_len/2;
+      size_t len= chunk_end - chunk_start;
+
+      size_t from= (len * shard) / num_shards;
+      size_t to= (len * (shard + 1)) / num_shards;
+
+      // Sum up the windows ending right before the shard
+      float acc_ref= 0;
+      gr_complex acc_detect= 0;
+
+      for(size_t i=from; i<(from + window_len); i++) {
+        acc_ref+= ref_terms[i];
+      }
+
+      for(size_t i=from; i<(from + half_len); i++) {
+        acc_detect+= det_terms[i];
+      }
+
+      // Slide the windows over the shard
+      for(size_t i=from; i<to; i++) {
+        acc_ref+= ref_terms[i + window_len] - ref_terms[i];
+        acc_detect+= det_terms[i + half_len] - det_terms[i];
+
+        ref_energy[i]= acc_ref;
+        det_energy[i]= acc_detect;
+      }
+
+      volk_32fc_magnitude_32f(&relative_power[from], &det_energy[from], to - from);
+
+      for(size_t i=from; i<to; i++) {
+        /* See d_energy_history_t::det_power_relative()
+         * for an explanation of the 2 */
+        relative_power[i]= (ref_energy[i] > 0) ?
+          (2 * relative_power[i] / ref_energy[i]) : 0;
+      }
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_window_metric_t::prepare(const gr_complex *in,
+                                                          int64_t start, int64_t limit)
+    {
+      chunk_start= start;
+      chunk_end= std::min(start + (int64_t)chunk_len, limit);
+
+      /* Every shard has to be at least one symbol long,
+       * otherwise summing up the windows at the start of each
+       * shard would take longer than sliding them over it. */
+      size_t len= chunk_end - chunk_start;
+      int num_shards= std::max(1, std::min(num_threads, (int)(len / shard_len_min)));
+
+      if(num_shards > 1) {
+        pool->run(num_shards,
+                  boost::bind(&d_window_metric_t::calc_terms, this, in, _1, num_shards));
+
+        pool->run(num_shards,
+                  boost::bind(&d_window_metric_t::slide_windows, this, _1, num_shards));
+      }
+      else {
+        calc_terms(in, 0, 1);
+        slide_windows(0, 1);
+      }
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_window_metric_t::update(const gr_complex *in,
+                                                         int64_t idx, int64_t limit)
+    {
+      if((idx < chunk_start) || (idx >= chunk_end)) {
+        prepare(in, idx, limit);
+      }
+
+      cur_idx= idx - chunk_start;
+
+      /* A jump in the input means the window does not
+       * consist of consecutive samples yet */
+      if(idx != next_idx) {
+        fill= 0;
+      }
+
+      if(fill < window_len) {
+        fill++;
+      }
+
+      next_idx= idx + 1;
+    }
+
+    gr_complex
+    ho_schmidl_cox_gate_impl::d_window_metric_t::det_energy_raw()
+    {
+      return ((fill >= window_len) ? det_energy[cur_idx] : 0);
+    }
+
+    float
+    ho_schmidl_cox_gate_impl::d_window_metric_t::det_power_relative()
+    {
+      return ((fill >= window_len) ? relative_power[cur_idx] : 0);
+    }
+
+    ho_schmidl_cox_gate_impl::d_fine_timing_t::d_fine_timing_t(int fft_len, int cp_len,
+                                                              bool enabled)
+      : fft_len(fft_len),
+        /* The coarse peak lies on the plateau of up to cp_len samples
+         * in front of the actual start of the preamble.
+         * Side peaks of half the height, caused by the two identical
+         * halves, appear fft_len/2 samples away from the main peak */
+        search_before(cp_len / 4 + 1),
+        search_after(cp_len + cp_len / 4 + 1),
+        backoff(cp_len / 8)
+    {
+      if(!enabled) {
+        return;
+      }
+
+      /* With long cyclic prefixes a side peak would fall
+       * into the search range, and the start of the preamble
+       * could not be told from the cyclic prefix */
+      if(search_before + cp_len >= fft_len / 2) {
+        throw std::invalid_argument("ho_schmidl_cox_gate: fine_timing needs cp_len to be less than about 2/5 of fft_len");
+      }
+
+      /* Regenerate the preamble the way the transmitter does.
+       * Its scaling does not matter for finding the peak */
+      std::vector<gr_complex> preamble_a, preamble_b;
+
+      ho_schmidlcox_preamble(fft_len, preamble_a, preamble_b);
+
+      ref.resize(fft_len);
+      ho_symbol_modulator(fft_len, 0, true, 0).modulate(&preamble_a[0], &ref[0]);
+
+      window.resize(search_before + search_after + fft_len + 1);
+    }
+
+    int64_t
+    ho_schmidl_cox_gate_impl::d_fine_timing_t::refine(const gr_complex *in,
+                                                      int64_t coarse_idx,
+                                                      int64_t lo, int64_t hi,
+                                                      float rot_per_sample)
+    {
+      int64_t first= std::max(coarse_idx - search_before, lo);
+      int64_t last= std::min(coarse_idx + search_after, hi - fft_len);
+
+      if(last < first) {
+        return coarse_idx;
+      }
+
+      /* Remove the frequency offset first, otherwise the
+       * correlation would fade for offsets near one carrier spacing */
+      gr_complex phase= 1;
+
+      volk_32fc_s32fc_x2_rotator_32fc(&window[0], &in[first],
+                                      std::polar(1.0f, -rot_per_sample),
+                                      &phase, last - first + fft_len);
+
+      int64_t best_idx= coarse_idx;
+      float best_mag= -1;
+
+      for(int64_t idx=first; idx <= last; idx++) {
+        gr_complex corr;
+
+        volk_32fc_x2_conjugate_dot_prod_32fc(&corr, &window[idx - first],
+                                             &ref[0], fft_len);
+
+        if(std::norm(corr) > best_mag) {
+          best_mag= std::norm(corr);
+          best_idx= idx;
+        }
+      }
+
+      return std::max(best_idx - backoff, lo);
+    }
+
+    ho_schmidl_cox_gate_impl::d_integer_cfo_t::d_integer_cfo_t(int fft_len, int max_offset)
+      : fft_len(fft_len),
+        max_offset(max_offset > 0 ? max_offset : 0),
+        fft_plan(max_offset > 0 ? ho_fft_plan::get(fft_len, true) : ho_fft_plan::sptr())
+    {
+      if(!enabled()) {
+        return;
+      }
+
+      /* The estimate is the rotation per sample, which is
+       * ambiguous beyond half the sample rate */
+      if(max_offset >= fft_len / 2) {
+        throw std::invalid_argument("ho_schmidl_cox_gate: max_cfo_carriers has to be less than fft_len/2");
+      }
+
+      std::vector<gr_complex> preamble_a, preamble_b;
+
+      ho_schmidlcox_preamble(fft_len, preamble_a, preamble_b);
+
+      for(int i=0; i<fft_len; i++) {
+        if(preamble_a[i] == gr_complex(0, 0)) {
+          continue;
+        }
+
+        /* The preambles are sent with DC in the center,
+         * see ho_symbol_modulator. Shifted bin i is unshifted
+         * bin i - fft_len/2, like the std::rotate below */
+        bins.push_back((i + (fft_len + 1) / 2) % fft_len);
+        ratios.push_back(std::conj(preamble_b[i] / preamble_a[i]));
+      }
+
+      sym_a.resize(fft_len);
+      sym_b.resize(fft_len);
+      product.resize(2 * fft_len);
+    }
+
+    int
+    ho_schmidl_cox_gate_impl::d_integer_cfo_t::estimate(const gr_complex *a,
+                                                        const gr_complex *b,
+                                                        float rot_per_sample)
+    {
+      /* Remove the already known part of the offset
+       * to reduce the inter carrier interference */
+      gr_complex phase= 1;
+      volk_32fc_s32fc_x2_rotator_32fc(&sym_a[0], a, std::polar(1.0f, -rot_per_sample),
+                                      &phase, fft_len);
+
+      phase= 1;
+      volk_32fc_s32fc_x2_rotator_32fc(&sym_b[0], b, std::polar(1.0f, -rot_per_sample),
+                                      &phase, fft_len);
+
+      fft_plan->execute(&sym_a[0]);
+      fft_plan->execute(&sym_b[0]);
+
+      /* Stored twice, so that shifted bins
+       * do not have to be wrapped around */
+      volk_32fc_x2_multiply_conjugate_32fc(&product[0], &sym_b[0], &sym_a[0], fft_len);
+      std::copy(product.begin(), product.begin() + fft_len, product.begin() + fft_len);
+
+      int best_offset= 0;
+      float best_mag= -1;
+
+      /* The remaining offset is a multiple of two carriers */
+      for(int offset= -(max_offset & ~1); offset <= max_offset; offset+= 2) {
+        int shift= offset + fft_len;
+        gr_complex acc= 0;
+
+        for(size_t i=0; i<bins.size(); i++) {
+          acc+= product[(bins[i] + shift) % (2 * fft_len)] * ratios[i];
+        }
+
+        if(std::norm(acc) > best_mag) {
+          best_mag= std::norm(acc);
+          best_offset= offset;
+        }
+      }
+
+      return best_offset;
+    }
+
+    ho_schmidl_cox_gate_impl::d_stats_t::d_stats_t()
+      : samples_scanned(0),
+        preambles_detected(0),
+        realign_failures(0),
+        frames_aborted(0),
+        frames_acked(0)
+    {
+      for(int i=0; i<hist_bins; i++) {
+        preamble_power_hist[i]= 0;
+        cfo_hist[i]= 0;
+      }
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_stats_t::count(std::atomic<uint64_t> &counter, uint64_t n)
+    {
+      /* There is only one writer, see the comment in the header */
+      counter.store(counter.load(std::memory_order_relaxed) + n,
+                    std::memory_order_relaxed);
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::d_stats_t::count_hist(std::atomic<uint64_t> *hist,
+                                                    float value, float lo, float hi)
+    {
+      int bin= (int)std::floor((value - lo) / (hi - lo) * hist_bins);
+
+      count(hist[std::min(std::max(bin, 0), hist_bins - 1)]);
+    }
+
+    pmt::pmt_t
+    ho_schmidl_cox_gate_impl::d_stats_t::to_dict() const
+    {
+      uint64_t power_hist[hist_bins];
+      uint64_t fq_hist[hist_bins];
+
+      for(int i=0; i<hist_bins; i++) {
+        power_hist[i]= preamble_power_hist[i].load(std::memory_order_relaxed);
+        fq_hist[i]= cfo_hist[i].load(std::memory_order_relaxed);
+      }
+
+      pmt::pmt_t dict= pmt::make_dict();
+
+      dict= pmt::dict_add(dict, pmt::mp("samples_scanned"),
+                          pmt::from_uint64(samples_scanned.load(std::memory_order_relaxed)));
+      dict= pmt::dict_add(dict, pmt::mp("preambles_detected"),
+                          pmt::from_uint64(preambles_detected.load(std::memory_order_relaxed)));
+      dict= pmt::dict_add(dict, pmt::mp("realign_failures"),
+                          pmt::from_uint64(realign_failures.load(std::memory_order_relaxed)));
+      dict= pmt::dict_add(dict, pmt::mp("frames_aborted"),
+                          pmt::from_uint64(frames_aborted.load(std::memory_order_relaxed)));
+      dict= pmt::dict_add(dict, pmt::mp("frames_acked"),
+                          pmt::from_uint64(frames_acked.load(std::memory_order_relaxed)));
+      dict= pmt::dict_add(dict, pmt::mp("preamble_power_hist"),
+                          pmt::init_u64vector(hist_bins, power_hist));
+      dict= pmt::dict_add(dict, pmt::mp("cfo_hist"),
+                          pmt::init_u64vector(hist_bins, fq_hist));
+
+      return dict;
+    }
+
     ho_schmidl_cox_gate::sptr
-    ho_schmidl_cox_gate::make(int fft_len, int cp_len, float rel_pw_lo, float rel_pw_hi)
+    ho_schmidl_cox_gate::make(int fft_len, int cp_len, float rel_pw_lo, float rel_pw_hi,
+                              bool block_metric, int num_threads,
+                              bool fft_out, bool fft_shift,
+                              int max_frame_symbols, bool fine_timing,
+                              int max_cfo_carriers)
     {
       return gnuradio::get_initial_sptr
-        (new ho_schmidl_cox_gate_impl(fft_len, cp_len, rel_pw_lo, rel_pw_hi));
+        (new ho_schmidl_cox_gate_impl(fft_len, cp_len, rel_pw_lo, rel_pw_hi,
+                                      block_metric, num_threads,
+                                      fft_out, fft_shift,
+                                      max_frame_symbols, fine_timing,
+                                      max_cfo_carriers));
     }
 
     ho_schmidl_cox_gate_impl::ho_schmidl_cox_gate_impl(int fft_len, int cp_len,
-                                                       float rel_pw_lo, float rel_pw_hi)
+                                                       float rel_pw_lo, float rel_pw_hi,
+                                                       bool block_metric, int num_threads,
+                                                       bool fft_out, bool fft_shift,
+                                                       int max_frame_symbols,
+                                                       bool fine_timing,
+                                                       int max_cfo_carriers)
       : gr::block("ho_schmidl_cox_gate",
                   gr::io_signature::make(1, 1, sizeof(gr_complex)),
                   gr::io_signature::make(1, 1, sizeof(gr_complex) * fft_len)),
       d_lengths({.fft=fft_len, .cp=cp_len, .preamble=fft_len/2}),
       d_relative_thresholds({.low=rel_pw_lo, .high=rel_pw_hi}),
       d_energy_history(fft_len),
+      d_window_metric(fft_len, fft_len + cp_len, num_threads),
+      d_block_metric(block_metric),
       d_power_peak({.am_inside=false, .relative_power=0, .energy=0, .abs_idx=0}),
-      d_fq_compensation({.phase_acc=1, .phase_rot=1}),
+      d_fq_compensation({.rot_per_sample=0, .phase_acc=1, .phase_rot=1, .cp_rot=1}),
+      d_fft_plan(fft_out ? ho_fft_plan::get(fft_len, true) : ho_fft_plan::sptr()),
+      d_fft_shift(fft_shift),
+      d_max_frame_symbols(max_frame_symbols > 0 ? max_frame_symbols : 0),
+      d_fine_timing(fft_len, cp_len, fine_timing),
+      d_integer_cfo(fft_len, max_cfo_carriers),
       d_am_aligned(false),
-      d_frame_id(0)
+      d_frame_id(0),
+      d_frame_pending(false),
+      d_frame_symbols(0),
+      d_frame_len(0),
+      d_stats_interval(1 << 20),
+      d_stats_published_at(0)
     {
       // TODO: find out if the +1 is necessary
       set_history(fft_len + 1);
@@ -124,6 +613,8 @@ namespace gr {
       message_port_register_in(frame_ack_port);
       set_msg_handler(frame_ack_port,
                       boost::bind(&ho_schmidl_cox_gate_impl::on_frame_ack, this, _1));
+
+      message_port_register_out(pmt::mp("stats"));
     }
 
     /*
@@ -133,20 +624,106 @@ namespace gr {
     {
     }
 
+    void
+    ho_schmidl_cox_gate_impl::setup_rpc()
+    {
+#ifdef GR_CTRLPORT
+      add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_get<ho_schmidl_cox_gate, pmt::pmt_t>(
+          alias(), "stats",
+          &ho_schmidl_cox_gate::get_stats,
+          pmt::make_dict(), pmt::make_dict(), pmt::make_dict(),
+          "", "Frame detection statistics", RPC_PRIVLVL_MIN,
+          DISPNULL)));
+#endif /* GR_CTRLPORT */
+    }
+
+    pmt::pmt_t
+    ho_schmidl_cox_gate_impl::get_stats()
+    {
+      return d_stats.to_dict();
+    }
+
+    void
+    ho_schmidl_cox_gate_impl::set_stats_interval(int num_samples)
+    {
+      d_stats_interval= (num_samples > 0) ? num_samples : 0;
+    }
+
     void
     ho_schmidl_cox_gate_impl::on_frame_ack(pmt::pmt_t msg)
     {
       /* A later block can notify us, using this message port,
        * that it has finished processing a frame and that
-       * we can stop outputting its symbols */
+       * we can stop outputting its symbols.
+       * The message is either just the frame_id, to stop right away,
+       * or a pair (frame_id . n) to stop after n symbols of the
+       * frame (including the preamble) were output */
 
       if(msg && pmt::is_number(msg)) {
         uint64_t ack_id= pmt::to_uint64(msg);
 
         if(ack_id == d_frame_id) {
+          d_stats_t::count(d_stats.frames_acked);
+
           d_am_aligned= false;
         }
       }
+
+      if(msg && pmt::is_pair(msg)
+         && pmt::is_number(pmt::car(msg)) && pmt::is_number(pmt::cdr(msg))) {
+
+        uint64_t ack_id= pmt::to_uint64(pmt::car(msg));
+        uint64_t frame_len= pmt::to_uint64(pmt::cdr(msg));
+
+        if(ack_id == d_frame_id) {
+          d_stats_t::count(d_stats.frames_acked);
+
+          d_frame_len= frame_len;
+
+          if(d_frame_symbols >= d_frame_len) {
+            d_am_aligned= false;
+          }
+        }
+      }
+    }
+
+    int64_t
+    ho_schmidl_cox_gate_impl::start_frame(const gr_complex *in, int64_t idx_in,
+                                          int64_t lo, int64_t hi, uint64_t tag_offset)
+    {
+      /* Called before the first symbol of a frame is output.
+       * Both preamble symbols are in the input buffer at this point */
+      float rot_per_sample= d_fq_compensation.rot_per_sample;
+
+      if(d_integer_cfo.enabled()) {
+        int offset= d_integer_cfo.estimate(&in[idx_in],
+                                           &in[idx_in + d_lengths.fft + d_lengths.cp],
+                                           rot_per_sample);
+
+        rot_per_sample+= 2 * M_PI * offset / d_lengths.fft;
+      }
+
+      if(d_fine_timing.enabled()) {
+        idx_in= d_fine_timing.refine(in, idx_in, lo, hi, rot_per_sample);
+      }
+
+      d_fq_compensation.phase_rot= std::polar(1.0f, -rot_per_sample);
+
+      /* The rotation over a cyclic prefix is the same for
+       * every symbol of the frame */
+      d_fq_compensation.cp_rot= std::polar(1.0f, -rot_per_sample * d_lengths.cp);
+
+      float range= d_integer_cfo.range();
+
+      d_stats_t::count_hist(d_stats.cfo_hist,
+                            rot_per_sample * d_lengths.fft / (2 * M_PI), -range, range);
+
+      add_item_tag(0, tag_offset,
+                   pmt::mp("fq_compensation"),
+                   pmt::from_double(-rot_per_sample));
+
+      return idx_in;
     }
 
     void
@@ -177,6 +754,13 @@ namespace gr {
        * idx_out is counted in output symbols (fft_len samples) */
       int idx_in=0, idx_out=0;
 
+      /* The windows scanned below never reach beyond this index
+       * into the input buffer */
+      int64_t metric_limit= (len_in - in_alignment - 1) + in_alignment + d_lengths.fft - 1;
+
+      // Negative indices down to this one point into the history
+      int64_t history_start= -((int64_t)history() - 1);
+
       /* The loop makes sure there is always at least one complete symbol in
        * the input buffer and space for one output symbol in the output buffer */
       while((idx_in < (len_in - in_alignment - 1)) && (idx_out < len_out)) {
@@ -184,23 +768,67 @@ namespace gr {
         /* If we are currently synchronized to a frame:
          * write a symbol from it to the output buffer. */
         if(d_am_aligned) {
+          if(d_frame_pending) {
+            d_frame_pending= false;
+
+            idx_in= start_frame(in, idx_in, history_start, metric_limit + 1,
+                                nitems_written(0) + idx_out);
+
+            /* Fine timing may have moved the start of the frame,
+             * check that the symbol is still completely in the buffer */
+            continue;
+          }
+
           /* The phase accumulator might degenerate because of
-           * accumulated rounding errors. Make sure it stays normalized. */
-          d_fq_compensation.phase_acc/= abs(d_fq_compensation.phase_acc);
+           * accumulated rounding errors. Make sure it stays normalized.
+           * It is always close to the unit circle, so a first order
+           * correction of its magnitude is good enough and saves
+           * the square root and division. */
+          d_fq_compensation.phase_acc*= 1.5f - 0.5f * norm(d_fq_compensation.phase_acc);
+
+          gr_complex *out_symbol= &out[idx_out * out_alignment];
+
+          /* Multiplying the time domain samples by (-1)^n moves DC
+           * to the center of the FFT output. This is done for free
+           * by negating the per-sample rotation.
+           * For even FFT lengths the sign flips cancel out over a
+           * symbol and the phase accumulator is not affected */
+          bool shift_by_rotation= d_fft_plan && d_fft_shift && !(out_alignment % 2);
 
           /* Frequency shift and output the symbol but not the
            * cyclic prefix */
-          volk_32fc_s32fc_x2_rotator_32fc(&out[idx_out * out_alignment],
+          volk_32fc_s32fc_x2_rotator_32fc(out_symbol,
                                           &in[idx_in],
-                                          d_fq_compensation.phase_rot,
+                                          shift_by_rotation
+                                          ? -d_fq_compensation.phase_rot
+                                          : d_fq_compensation.phase_rot,
                                           &d_fq_compensation.phase_acc,
                                           out_alignment);
 
+          /* Transform the symbol right where it is, in the output buffer */
+          if(d_fft_plan) {
+            d_fft_plan->execute(out_symbol);
+
+            if(d_fft_shift && !shift_by_rotation) {
+              std::rotate(out_symbol,
+                          out_symbol + (out_alignment + 1) / 2,
+                          out_symbol + out_alignment);
+            }
+          }
+
           /* Fast forward the frequency compensation over the
            * next cyclic prefix */
-          d_fq_compensation.phase_acc*= pow(d_fq_compensation.phase_rot, d_lengths.cp);
+          d_fq_compensation.phase_acc*= d_fq_compensation.cp_rot;
 
           idx_out++;
+          d_frame_symbols++;
+
+          /* Stop at the frame length announced by a frame_ack
+           * or at the configured upper bound, whichever comes first */
+          if((d_frame_len && (d_frame_symbols >= d_frame_len))
+             || (d_max_frame_symbols && (d_frame_symbols >= d_max_frame_symbols))) {
+            d_am_aligned= false;
+          }
         }
 
         bool do_realign= false;
@@ -211,8 +839,16 @@ namespace gr {
             idx_win++) {
 
           // Add next item that slides into the window
-          d_energy_history.update(in[idx_win + d_lengths.fft]);
-          float relative_power= d_energy_history.det_power_relative();
+          float relative_power;
+
+          if(d_block_metric) {
+            d_window_metric.update(in, idx_win + d_lengths.fft, metric_limit);
+            relative_power= d_window_metric.det_power_relative();
+          }
+          else {
+            d_energy_history.update(in[idx_win + d_lengths.fft]);
+            relative_power= d_energy_history.det_power_relative();
+          }
 
           /* The Peaks in relative_power look something like the ACII-Art below:
            *
@@ -232,6 +868,11 @@ namespace gr {
           if (!d_power_peak.am_inside &&
               (relative_power > d_relative_thresholds.high)) {
 
+              /* A new preamble cuts the current frame short */
+              if(d_am_aligned) {
+                d_stats_t::count(d_stats.frames_aborted);
+              }
+
               d_am_aligned= false;
               d_power_peak.am_inside= true;
 
@@ -241,7 +882,8 @@ namespace gr {
           if (d_power_peak.am_inside) {
             if (relative_power > d_power_peak.relative_power) {
               d_power_peak.relative_power= relative_power;
-              d_power_peak.energy= d_energy_history.det_energy_raw();
+              d_power_peak.energy= d_block_metric ?
+                d_window_metric.det_energy_raw() : d_energy_history.det_energy_raw();
               d_power_peak.abs_idx= nitems_read(0) + idx_win;
             }
 
@@ -250,9 +892,9 @@ namespace gr {
 
               idx_in_realigned= d_power_peak.abs_idx - (int64_t)nitems_read(0);
 
-              int64_t history_start= -((int64_t)history() - 1);
-
               if((idx_in_realigned < history_start) || (idx_in_realigned > len_in)) {
+                d_stats_t::count(d_stats.realign_failures);
+
                 fprintf(stderr,
                         "schmid_cox_gate: realignment failed, idx_in_realigned=%li is out of bounds\n",
                         idx_in_realigned);
@@ -265,25 +907,32 @@ namespace gr {
                  * of peaks until it is filled again.
                  * This is a bit hackish, i know. */
                 d_energy_history.reset();
+                d_window_metric.reset();
 
                 /* The preamble was shifted by the phase of d_power_peak.energy in
                  * d_lengths.preamble samples times, the following lines calculate the
-                 * phase shift per sample, invert it and store it
+                 * phase shift per sample and store it
                  * for later frequency offset compensation.
-                 * For large frequency offsets this can become abiguos,
-                 * to determine the maximum offset is left as an exercise to the reader. */
-                gr_complex rot_per_sample= pow(d_power_peak.energy,
-                                               1.0f/d_lengths.preamble);
+                 * Offsets beyond one carrier spacing are ambiguous,
+                 * start_frame() resolves this if d_integer_cfo is enabled.
+                 * Only the phase is of interest, so instead of taking the
+                 * complex root of the energy its argument is divided. */
+                d_fq_compensation.rot_per_sample= arg(d_power_peak.energy) / d_lengths.preamble;
 
-                gr_complex norm_rot_per_sample= rot_per_sample / abs(rot_per_sample);
-
-                d_fq_compensation.phase_rot= conj(norm_rot_per_sample);
+                d_stats_t::count(d_stats.preambles_detected);
+                d_stats_t::count_hist(d_stats.preamble_power_hist,
+                                      d_power_peak.relative_power, 0, 1);
 
                 /* Add a tag to the output stream to notify the following
-                 * blocks of the new frame*/
+                 * blocks of the new frame.
+                 * The fq_compensation tag is added by start_frame() */
                 uint64_t idx_abs= nitems_written(0) + idx_out;
 
                 d_frame_id++;
+                d_frame_pending= true;
+                d_frame_symbols= 0;
+                d_frame_len= 0;
+
                 add_item_tag(0, idx_abs,
                              pmt::mp("frame_id"),
                              pmt::from_uint64(d_frame_id));
@@ -292,10 +941,6 @@ namespace gr {
                              pmt::mp("preamble_power"),
                              pmt::from_double(d_power_peak.relative_power));
 
-                add_item_tag(0, idx_abs,
-                             pmt::mp("fq_compensation"),
-                             pmt::from_double(arg(d_fq_compensation.phase_rot)));
-
                 /* Jump back to the start of the preamble */
                 do_realign= true;
                 d_am_aligned= true;
@@ -307,6 +952,21 @@ namespace gr {
         idx_in= do_realign ? idx_in_realigned : (idx_in + in_alignment);
       }
 
+      d_window_metric.invalidate(idx_in);
+
+      if(idx_in > 0) {
+        d_stats_t::count(d_stats.samples_scanned, idx_in);
+      }
+
+      uint64_t stats_interval= d_stats_interval.load(std::memory_order_relaxed);
+      uint64_t samples_scanned= d_stats.samples_scanned.load(std::memory_order_relaxed);
+
+      if(stats_interval && (samples_scanned - d_stats_published_at >= stats_interval)) {
+        message_port_pub(pmt::mp("stats"), d_stats.to_dict());
+
+        d_stats_published_at= samples_scanned;
+      }
+
       consume_each (idx_in);
       return idx_out;
     }
@@ -22,6 +22,9 @@
 #define INCLUDED_HNEZ_OFDM_HO_SCHMIDL_COX_GATE_IMPL_H
 
 #include <hnez_ofdm/ho_schmidl_cox_gate.h>
+#include <atomic>
+#include "ho_worker_pool.h"
+#include "ho_fft_plan.h"
 
 namespace gr {
   namespace hnez_ofdm {
@@ -47,11 +50,16 @@ namespace gr {
 
         size_t history_idx;
 
+        const size_t resum_interval;
+        size_t resum_countdown;
+
         float acc_ref;
         gr_complex acc_detect;
 
         bool ready;
 
+        void resum();
+
       public:
         d_energy_history_t(size_t fft_len);
 
@@ -62,6 +70,52 @@ namespace gr {
         float det_power_relative();
       } d_energy_history;
 
+      /* Block processing variant of d_energy_history_t.
+       * Instead of pushing single samples through a ring buffer
+       * the correlation and energy terms are calculated for a whole
+       * chunk of the input buffer at once using VOLK kernels.
+       * update() then only has to look up the precalculated values. */
+      struct d_window_metric_t{
+      private:
+        const size_t window_len;
+        const size_t shard_len_min;
+        const int num_threads;
+        const size_t chunk_len;
+
+        const std::unique_ptr<ho_worker_pool> pool;
+
+        float *ref_terms;
+        gr_complex *det_terms;
+
+        float *ref_energy;
+        gr_complex *det_energy;
+        float *relative_power;
+
+        int64_t chunk_start;
+        int64_t chunk_end;
+        int64_t cur_idx;
+        int64_t next_idx;
+
+        size_t fill;
+
+        void calc_terms(const gr_complex *in, int shard, int num_shards);
+        void slide_windows(int shard, int num_shards);
+        void prepare(const gr_complex *in, int64_t start, int64_t limit);
+
+      public:
+        d_window_metric_t(size_t fft_len, size_t symbol_len, int num_threads);
+        ~d_window_metric_t();
+
+        void update(const gr_complex *in, int64_t idx, int64_t limit);
+        void reset();
+        void invalidate(int64_t consumed);
+
+        gr_complex det_energy_raw();
+        float det_power_relative();
+      } d_window_metric;
+
+      const bool d_block_metric;
+
       struct {
         bool am_inside;
         float relative_power;
@@ -70,21 +124,148 @@ namespace gr {
       } d_power_peak;
 
       struct {
+        /* The offset estimated from the phase of the preamble
+         * correlation, radians per sample */
+        float rot_per_sample;
+
         gr_complex phase_acc;
         gr_complex phase_rot;
+        gr_complex cp_rot;
       } d_fq_compensation;
 
+      /* When set the symbols are transformed into the
+       * frequency domain before they are output.
+       * d_fft_plan is left empty otherwise. */
+      const ho_fft_plan::sptr d_fft_plan;
+      const bool d_fft_shift;
+
+      // Upper bound for the symbols output per frame (0 = unbounded)
+      const uint64_t d_max_frame_symbols;
+
+      /* Refines the coarse frame start found by the metric
+       * using a cross-correlation with the time domain waveform
+       * of preamble_a. ref is left empty when fine timing is disabled. */
+      struct d_fine_timing_t{
+      private:
+        const int fft_len;
+        const int search_before;
+        const int search_after;
+        const int backoff;
+
+        std::vector<gr_complex> ref;
+        std::vector<gr_complex> window;
+
+      public:
+        d_fine_timing_t(int fft_len, int cp_len, bool enabled);
+
+        bool enabled() const { return !ref.empty(); }
+
+        /* Return the refined start of the preamble
+         * symbol near coarse_idx. Only samples in[lo] to in[hi - 1]
+         * are looked at. rot_per_sample is the frequency offset
+         * estimated from the preamble. */
+        int64_t refine(const gr_complex *in, int64_t coarse_idx,
+                       int64_t lo, int64_t hi, float rot_per_sample);
+      } d_fine_timing;
+
+      /* Estimates the part of the carrier frequency offset that
+       * the phase of the preamble correlation can not tell apart
+       * (multiples of two carrier spacings) by comparing the spectra
+       * of both preamble symbols. The carriers occupied in preamble_a
+       * carry the same channel in both symbols, so multiplying the
+       * conjugated spectrum of the first symbol with the spectrum of the
+       * second one leaves only the known ratio preamble_b/preamble_a.
+       * This ratio is searched for at every possible offset.
+       * fft_plan is left empty when the estimation is disabled. */
+      struct d_integer_cfo_t{
+      private:
+        const int fft_len;
+        const int max_offset;
+
+        const ho_fft_plan::sptr fft_plan;
+
+        std::vector<int> bins;
+        std::vector<gr_complex> ratios;
+
+        std::vector<gr_complex> sym_a;
+        std::vector<gr_complex> sym_b;
+        std::vector<gr_complex> product;
+
+      public:
+        d_integer_cfo_t(int fft_len, int max_offset);
+
+        bool enabled() const { return bool(fft_plan); }
+        int range() const { return max_offset + 1; }
+
+        /* Return the remaining offset in carrier spacings.
+         * a and b point to the first sample (after the cyclic prefix)
+         * of both preamble symbols, rot_per_sample is the offset
+         * estimated from the correlation phase. */
+        int estimate(const gr_complex *a, const gr_complex *b,
+                     float rot_per_sample);
+      } d_integer_cfo;
+
       bool d_am_aligned;
       uint64_t d_frame_id;
 
+      // Set when a frame was detected but start_frame() was not called yet
+      bool d_frame_pending;
+
+      /* Symbols output for the current frame and its length
+       * as announced by a frame_ack message (0 = unknown) */
+      uint64_t d_frame_symbols;
+      uint64_t d_frame_len;
+
+      /* Counters for get_stats() and the stats port.
+       * They are only ever written by the thread calling general_work
+       * (message handlers run on it as well), so incrementing them
+       * is a plain load and store without a lock or atomic
+       * read-modify-write. The atomics only make sure other
+       * threads calling get_stats() see consistent values. */
+      struct d_stats_t{
+        static const int hist_bins= 16;
+
+        std::atomic<uint64_t> samples_scanned;
+        std::atomic<uint64_t> preambles_detected;
+        std::atomic<uint64_t> realign_failures;
+        std::atomic<uint64_t> frames_aborted;
+        std::atomic<uint64_t> frames_acked;
+
+        std::atomic<uint64_t> preamble_power_hist[hist_bins];
+        std::atomic<uint64_t> cfo_hist[hist_bins];
+
+        d_stats_t();
+
+        static void count(std::atomic<uint64_t> &counter, uint64_t n=1);
+        static void count_hist(std::atomic<uint64_t> *hist,
+                               float value, float lo, float hi);
+
+        pmt::pmt_t to_dict() const;
+      } d_stats;
+
+      std::atomic<uint64_t> d_stats_interval;
+      uint64_t d_stats_published_at;
+
       void on_frame_ack(pmt::pmt_t msg);
 
+      int64_t start_frame(const gr_complex *in, int64_t idx_in,
+                          int64_t lo, int64_t hi, uint64_t tag_offset);
+
     public:
       ho_schmidl_cox_gate_impl(int fft_len, int cp_len,
-                               float rel_pw_lo, float rel_pw_hi);
+                               float rel_pw_lo, float rel_pw_hi,
+                               bool block_metric, int num_threads,
+                               bool fft_out, bool fft_shift,
+                               int max_frame_symbols, bool fine_timing,
+                               int max_cfo_carriers);
 
       ~ho_schmidl_cox_gate_impl();
 
+      void setup_rpc();
+
+      pmt::pmt_t get_stats();
+      void set_stats_interval(int num_samples);
+
       void forecast (int noutput_items, gr_vector_int &ninput_items_required);
 
       int general_work(int noutput_items,
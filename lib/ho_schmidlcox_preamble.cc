@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <stdint.h>
+#include "ho_schmidlcox_preamble.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    static bool
+    lfsr (uint32_t *state)
+    {
+      uint_fast8_t bit= (*state) & 1;
+
+      (*state)>>= 1;
+
+      if(bit) (*state)^= 0x80000057;
+
+      return bit;
+    }
+
+    void
+    ho_schmidlcox_preamble(int fft_len,
+                           std::vector<gr_complex> &preamble_a,
+                           std::vector<gr_complex> &preamble_b)
+    {
+      preamble_a.resize(fft_len);
+      preamble_b.resize(fft_len);
+
+      uint32_t lfsr_state= 1;
+
+      for(int i=0; i<fft_len; i++) {
+        preamble_a[i]= gr_complex(lfsr(&lfsr_state) ? M_SQRT2 : -M_SQRT2,
+                                  lfsr(&lfsr_state) ? M_SQRT2 : -M_SQRT2);
+
+        preamble_b[i]= gr_complex(lfsr(&lfsr_state) ? M_SQRT1_2 : -M_SQRT1_2,
+                                  lfsr(&lfsr_state) ? M_SQRT1_2 : -M_SQRT1_2);
+
+        /* In the first preamble symbol only every
+           second carrier is occupied */
+        if (i%2) preamble_a[i]= 0;
+      }
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,45 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_SCHMIDLCOX_PREAMBLE_H
+#define INCLUDED_HNEZ_OFDM_HO_SCHMIDLCOX_PREAMBLE_H
+
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Generate the two frequency domain preamble symbols of
+     * fft_len carriers each that ho_add_schmidlcox puts in front
+     * of every frame.
+     * In preamble_a only every second carrier is occupied,
+     * resulting in two identical halves in the time domain
+     * that ho_schmidl_cox_gate can detect.
+     * preamble_b occupies every carrier and can be used by the
+     * receiver to estimate the channel. */
+    void ho_schmidlcox_preamble(int fft_len,
+                                std::vector<gr_complex> &preamble_a,
+                                std::vector<gr_complex> &preamble_b);
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_SCHMIDLCOX_PREAMBLE_H */
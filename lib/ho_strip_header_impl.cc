@@ -0,0 +1,101 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include "ho_strip_header_impl.h"
+#include "ho_crc32.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_strip_header::sptr
+    ho_strip_header::make(const std::string& len_tag_key)
+    {
+      return gnuradio::get_initial_sptr
+        (new ho_strip_header_impl(len_tag_key));
+    }
+
+    /*
+     * The private constructor
+     */
+    ho_strip_header_impl::ho_strip_header_impl(const std::string& len_tag_key)
+      : gr::tagged_stream_block("ho_strip_header",
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                                len_tag_key)
+    {
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ho_strip_header_impl::~ho_strip_header_impl()
+    {
+    }
+
+    int
+    ho_strip_header_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      int noutput_items = std::max(ninput_items[0] - 8, 0);
+      return noutput_items ;
+    }
+
+    int
+    ho_strip_header_impl::work (int noutput_items,
+                                gr_vector_int &ninput_items,
+                                gr_vector_const_void_star &input_items,
+                                gr_vector_void_star &output_items)
+    {
+      const uint8_t *in = (const uint8_t *) input_items[0];
+      uint8_t *out = (uint8_t *) output_items[0];
+
+      if(ninput_items[0] < 8) {
+        return 0;
+      }
+
+      uint32_t payload_len= ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16)
+        | ((uint32_t)in[2] << 8) | in[3];
+
+      uint32_t crc= ((uint32_t)in[4] << 24) | ((uint32_t)in[5] << 16)
+        | ((uint32_t)in[6] << 8) | in[7];
+
+      /* Coding may have added padding behind the payload
+       * but the payload can not be longer than the packet */
+      if(payload_len > (uint32_t)(ninput_items[0] - 8)) {
+        return 0;
+      }
+
+      /* The payload is copied to the output while checking it,
+       * dropping the packet just means not telling anyone */
+      if(ho_crc32_copy(out, &in[8], payload_len) != crc) {
+        return 0;
+      }
+
+      // Tell runtime system how many output items we produced.
+      return payload_len;
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,91 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include "ho_symbol_modulator.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_symbol_modulator::ho_symbol_modulator(int fft_len, int cp_len,
+                                             bool fft_shift, int window_len)
+      : d_fft_len(fft_len),
+        d_cp_len(cp_len),
+        d_fft_shift(fft_shift),
+        d_window_len(window_len),
+        d_fft_plan(ho_fft_plan::get(fft_len, false)),
+        d_ramp(window_len),
+        d_tail(window_len, 0)
+    {
+      if((cp_len < 0) || (cp_len > fft_len)) {
+        throw std::invalid_argument("ho_symbol_modulator: cp_len has to be between 0 and fft_len");
+      }
+
+      if((window_len < 0) || (window_len > cp_len)) {
+        throw std::invalid_argument("ho_symbol_modulator: window_len may not exceed cp_len");
+      }
+
+      /* The fade in and the fade out of the previous
+       * symbol always add up to one */
+      for(int i=0; i<window_len; i++) {
+        d_ramp[i]= 0.5f - 0.5f * cosf(M_PI * (i + 0.5f) / window_len);
+      }
+    }
+
+    void
+    ho_symbol_modulator::modulate(const gr_complex *in, gr_complex *out)
+    {
+      gr_complex *body= &out[d_cp_len];
+
+      /* Undo the fft shift while copying the input to
+       * its final place, the IFFT is then done in place.
+       * DC is at fft_len/2 of the input, which for odd
+       * fft_len is not the same as swapping the halves */
+      if(d_fft_shift) {
+        int half= d_fft_len/2;
+
+        memcpy(body, &in[half], sizeof(gr_complex) * (d_fft_len - half));
+        memcpy(&body[d_fft_len - half], in, sizeof(gr_complex) * half);
+      }
+      else {
+        memcpy(body, in, sizeof(gr_complex) * d_fft_len);
+      }
+
+      d_fft_plan->execute(body);
+
+      memcpy(out, &body[d_fft_len - d_cp_len], sizeof(gr_complex) * d_cp_len);
+
+      for(int i=0; i<d_window_len; i++) {
+        out[i]= out[i] * d_ramp[i] + d_tail[i];
+
+        /* The symbol continues cyclically
+         * into the next symbols prefix */
+        d_tail[i]= body[i] * (1.0f - d_ramp[i]);
+      }
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
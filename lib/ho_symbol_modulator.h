@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_SYMBOL_MODULATOR_H
+#define INCLUDED_HNEZ_OFDM_HO_SYMBOL_MODULATOR_H
+
+#include <gnuradio/gr_complex.h>
+#include <vector>
+#include "ho_fft_plan.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* Turns frequency domain symbols into time domain
+     * symbols with a cyclic prefix, the last step of the transmitter.
+     * The IFFT is computed directly in the output buffer
+     * and only the cyclic prefix is copied afterwards.
+     *
+     * With a window_len > 0 the first window_len samples of every
+     * cyclic prefix are faded in using a raised cosine and overlapped
+     * with the faded out cyclic continuation of the previous symbol.
+     * This smooths the phase jumps between symbols and
+     * reduces out of band emissions, at the cost of shortening
+     * the usable cyclic prefix by window_len samples. */
+    class ho_symbol_modulator
+    {
+    private:
+      const int d_fft_len;
+      const int d_cp_len;
+      const bool d_fft_shift;
+      const int d_window_len;
+
+      const ho_fft_plan::sptr d_fft_plan;
+
+      std::vector<float> d_ramp;
+      std::vector<gr_complex> d_tail;
+
+    public:
+      ho_symbol_modulator(int fft_len, int cp_len, bool fft_shift, int window_len);
+
+      /* Modulate one symbol of fft_len carriers from in
+       * into fft_len + cp_len samples at out.
+       * With fft_shift set the input is expected to
+       * have DC in the center, like the output of ho_assign_carriers.
+       * The output is not scaled. */
+      void modulate(const gr_complex *in, gr_complex *out);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_SYMBOL_MODULATOR_H */
@@ -0,0 +1,133 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <boost/bind.hpp>
+#include "ho_worker_pool.h"
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    ho_worker_pool::ho_worker_pool(int num_threads)
+      : d_num_jobs(0),
+        d_next_job(0),
+        d_jobs_done(0),
+        d_generation(0),
+        d_shutdown(false)
+    {
+      for(int i=1; i<num_threads; i++) {
+        d_threads.create_thread(boost::bind(&ho_worker_pool::worker, this));
+      }
+    }
+
+    ho_worker_pool::~ho_worker_pool()
+    {
+      {
+        gr::thread::scoped_lock lock(d_mutex);
+        d_shutdown= true;
+      }
+
+      d_wakeup.notify_all();
+      d_threads.join_all();
+    }
+
+    void
+    ho_worker_pool::process_jobs()
+    {
+      for(;;) {
+        int job_idx;
+
+        {
+          gr::thread::scoped_lock lock(d_mutex);
+
+          if(d_next_job >= d_num_jobs) {
+            return;
+          }
+
+          job_idx= d_next_job++;
+        }
+
+        d_job(job_idx);
+
+        {
+          gr::thread::scoped_lock lock(d_mutex);
+
+          if(++d_jobs_done == d_num_jobs) {
+            d_finished.notify_all();
+          }
+        }
+      }
+    }
+
+    void
+    ho_worker_pool::worker()
+    {
+      uint64_t generation_seen= 0;
+
+      for(;;) {
+        {
+          gr::thread::scoped_lock lock(d_mutex);
+
+          while(!d_shutdown && (d_generation == generation_seen)) {
+            d_wakeup.wait(lock);
+          }
+
+          if(d_shutdown) {
+            return;
+          }
+
+          generation_seen= d_generation;
+        }
+
+        process_jobs();
+      }
+    }
+
+    void
+    ho_worker_pool::run(int num_jobs, const job_t &job)
+    {
+      {
+        gr::thread::scoped_lock lock(d_mutex);
+
+        d_job= job;
+        d_num_jobs= num_jobs;
+        d_next_job= 0;
+        d_jobs_done= 0;
+
+        d_generation++;
+      }
+
+      d_wakeup.notify_all();
+
+      // Do not just sit around while the workers are busy
+      process_jobs();
+
+      gr::thread::scoped_lock lock(d_mutex);
+
+      while(d_jobs_done < d_num_jobs) {
+        d_finished.wait(lock);
+      }
+    }
+
+  } /* namespace hnez_ofdm */
+} /* namespace gr */
@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HNEZ_OFDM_HO_WORKER_POOL_H
+#define INCLUDED_HNEZ_OFDM_HO_WORKER_POOL_H
+
+#include <gnuradio/thread/thread.h>
+#include <boost/function.hpp>
+
+namespace gr {
+  namespace hnez_ofdm {
+
+    /* A fixed set of threads that a block can hand
+     * independent pieces of work to from inside its work function.
+     * The calling thread takes part in processing the jobs,
+     * so a pool of size n starts n-1 additional threads. */
+    class ho_worker_pool
+    {
+    public:
+      typedef boost::function<void(int)> job_t;
+
+    private:
+      gr::thread::thread_group d_threads;
+
+      gr::thread::mutex d_mutex;
+      gr::thread::condition_variable d_wakeup;
+      gr::thread::condition_variable d_finished;
+
+      job_t d_job;
+      int d_num_jobs;
+      int d_next_job;
+      int d_jobs_done;
+
+      uint64_t d_generation;
+      bool d_shutdown;
+
+      void worker();
+      void process_jobs();
+
+    public:
+      ho_worker_pool(int num_threads);
+      ~ho_worker_pool();
+
+      /* Call job(0) to job(num_jobs - 1) in parallel and
+       * return once all of them are done */
+      void run(int num_jobs, const job_t &job);
+    };
+
+  } // namespace hnez_ofdm
+} // namespace gr
+
+#endif /* INCLUDED_HNEZ_OFDM_HO_WORKER_POOL_H */
@@ -20,7 +20,6 @@
 #
 
 from gnuradio import gr
-from gnuradio import blocks
 import hnez_ofdm_swig as hnez_ofdm
 
 class ho_fec(gr.hier_block2):
@@ -35,17 +34,9 @@ class ho_fec(gr.hier_block2):
             gr.io_signature(1, 1, gr.sizeof_char)
         )
 
-        if encode:
-            repack_pre= blocks.repack_bits_bb(8, 4, len_tag_key, False, gr.GR_LSB_FIRST)
-            hamming= hnez_ofdm.ho_hamming74(True, len_tag_key)
-            repack_post= blocks.repack_bits_bb(7, 8, len_tag_key, False, gr.GR_LSB_FIRST)
+        # ho_hamming74_packed does the nibble <-> codeword
+        # repacking internally, no repack_bits_bb blocks needed
+        hamming= hnez_ofdm.ho_hamming74_packed(encode, len_tag_key)
 
-        else:
-            repack_pre= blocks.repack_bits_bb(8, 7, len_tag_key, False, gr.GR_LSB_FIRST)
-            hamming= hnez_ofdm.ho_hamming74(False, len_tag_key)
-            repack_post= blocks.repack_bits_bb(4, 8, len_tag_key, False, gr.GR_LSB_FIRST)
-
-        self.connect((self, 0), (repack_pre, 0))
-        self.connect((repack_pre, 0), (hamming, 0))
-        self.connect((hamming, 0), (repack_post, 0))
-        self.connect((repack_post, 0), (self, 0))
+        self.connect((self, 0), (hamming, 0))
+        self.connect((hamming, 0), (self, 0))
@@ -23,6 +23,8 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import hnez_ofdm_swig as hnez_ofdm
 
+import pmt
+
 class qa_ho_add_header (gr_unittest.TestCase):
 
     def setUp (self):
@@ -53,5 +55,50 @@ class qa_ho_add_header (gr_unittest.TestCase):
             actual_result[:len(expected_result)]
         )
 
+    def test_002_many_packets (self):
+        # Enough small packets to end up several in one work call
+        packets= tuple(
+            tuple((i * 37 + n) % 256 for i in range(n % 50 + 1))
+            for n in range(1000)
+        )
+
+        data= tuple(b for packet in packets for b in packet)
+        tags= []
+        offset= 0
+
+        for packet in packets:
+            tag= gr.tag_t()
+            tag.offset= offset
+            tag.key= pmt.intern("packet_len")
+            tag.value= pmt.from_long(len(packet))
+            tags.append(tag)
+
+            offset+= len(packet)
+
+        data_src= blocks.vector_source_b(data, False, 1, tags)
+        header_adder= hnez_ofdm.ho_add_header("packet_len")
+        dst= blocks.vector_sink_b()
+
+        self.tb.connect(data_src, header_adder, dst)
+        self.tb.run ()
+
+        len_tags= tuple(
+            (tag.offset, pmt.to_long(tag.value)) for tag in dst.tags()
+            if pmt.symbol_to_string(tag.key) == 'packet_len'
+        )
+
+        expected_tags= list()
+        offset= 0
+
+        for packet in packets:
+            expected_tags.append((offset, len(packet) + 8))
+            offset+= len(packet) + 8
+
+        self.assertSequenceEqual(sorted(len_tags), expected_tags)
+
+        # The payloads follow the headers unchanged
+        for ((offset, length), packet) in zip(expected_tags, packets):
+            self.assertSequenceEqual(dst.data()[offset + 8:offset + length], packet)
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ho_add_header, "qa_ho_add_header.xml")
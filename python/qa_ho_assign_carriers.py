@@ -23,6 +23,9 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import hnez_ofdm_swig as hnez_ofdm
 
+import numpy as np
+
+
 class qa_ho_assign_carriers (gr_unittest.TestCase):
 
     def setUp (self):
@@ -31,10 +34,98 @@ class qa_ho_assign_carriers (gr_unittest.TestCase):
     def tearDown (self):
         self.tb = None
 
-    def test_001_t (self):
-        # set up fg
-        self.tb.run ()
-        # check data
+    def assign(self, assigner, data, num_carriers, fft_len):
+        src= blocks.vector_source_c(data, False, num_carriers, [])
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_gr_complex, num_carriers,
+            len(data) // num_carriers, "packet_len"
+        )
+        dst= blocks.vector_sink_c(fft_len)
+
+        self.tb.connect(src, tagger, assigner, dst)
+        self.tb.run()
+
+        return np.array(dst.data()).reshape((-1, fft_len))
+
+    def test_001_spread (self):
+        num_carriers= 12
+        fft_len= 32
+
+        data= np.arange(num_carriers * 3) + 1j
+        assigner= hnez_ofdm.ho_assign_carriers(num_carriers, fft_len)
+
+        symbols= self.assign(assigner, data, num_carriers, fft_len)
+
+        bins= [(fft_len * i) // num_carriers for i in range(num_carriers)]
+        expected= np.ones((3, fft_len), dtype=complex)
+        expected[:, bins]= data.reshape((3, num_carriers))
+
+        self.assertComplexTuplesAlmostEqual(symbols.flatten(), expected.flatten(), 6)
+
+    def test_002_contiguous_pilots (self):
+        num_carriers= 8
+        fft_len= 16
+        pilot_carriers= [5, 11]
+        pilot_symbols= [1, -1]
+
+        data= np.arange(num_carriers * 2) + 1j
+        assigner= hnez_ofdm.ho_assign_carriers(
+            num_carriers, fft_len, "packet_len", True, 0,
+            pilot_carriers, pilot_symbols
+        )
+
+        symbols= self.assign(assigner, data, num_carriers, fft_len)
+
+        # DC (bin 8) and the band edges stay empty,
+        # the pilot bins are skipped
+        bins= [3, 4, 6, 7, 9, 10, 12, 13]
+        expected= np.zeros((2, fft_len), dtype=complex)
+        expected[:, bins]= data.reshape((2, num_carriers))
+        expected[:, pilot_carriers]= pilot_symbols
+
+        self.assertComplexTuplesAlmostEqual(symbols.flatten(), expected.flatten(), 6)
+
+    def test_003_add_preamble (self):
+        num_carriers= 12
+        fft_len= 32
+
+        data= np.arange(num_carriers * 3) + 1j
+
+        # The fused block gives the same output as
+        # a separate ho_add_schmidlcox block
+        src= blocks.vector_source_c(data, False, num_carriers, [])
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_gr_complex, num_carriers, 3, "packet_len"
+        )
+        assigner= hnez_ofdm.ho_assign_carriers(num_carriers, fft_len)
+        preamble= hnez_ofdm.ho_add_schmidlcox(fft_len)
+        expected= blocks.vector_sink_c(fft_len)
+
+        self.tb.connect(src, tagger, assigner, preamble, expected)
+        self.tb.run()
+
+        self.tb= gr.top_block()
+
+        fused= hnez_ofdm.ho_assign_carriers(
+            num_carriers, fft_len, "packet_len", False, 1, [], [], True
+        )
+
+        symbols= self.assign(fused, data, num_carriers, fft_len)
+
+        self.assertEqual(len(symbols), 5)
+        self.assertComplexTuplesAlmostEqual(symbols.flatten(), expected.data(), 6)
+
+    def test_004_invalid (self):
+        # The spread layout uses bin 0, a pilot may not go there
+        self.assertRaises(
+            ValueError,
+            lambda: hnez_ofdm.ho_assign_carriers(4, 16, "packet_len", False, 1, [0], [1])
+        )
+
+        self.assertRaises(
+            ValueError,
+            lambda: hnez_ofdm.ho_assign_carriers(4, 16, "packet_len", False, 1, [3], [])
+        )
 
 
 if __name__ == '__main__':
@@ -0,0 +1,118 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import pmt
+
+import numpy as np
+
+
+class qa_ho_extract_carriers (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def transmit(self, data, num_carriers, fft_len, contiguous, pilots):
+        tb= gr.top_block()
+
+        src= blocks.vector_source_c(data, False, num_carriers, [])
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_gr_complex, num_carriers,
+            len(data) // num_carriers, "packet_len"
+        )
+        assigner= hnez_ofdm.ho_assign_carriers(
+            num_carriers, fft_len, "packet_len", contiguous, 0,
+            pilots, [1] * len(pilots)
+        )
+        preamble= hnez_ofdm.ho_add_schmidlcox(fft_len)
+        dst= blocks.vector_sink_c(fft_len)
+
+        tb.connect(src, tagger, assigner, preamble, dst)
+        tb.run()
+
+        return np.array(dst.data()).reshape((-1, fft_len))
+
+    def frame_tag(self, offset, frame_id):
+        tag= gr.tag_t()
+        tag.offset= offset
+        tag.key= pmt.intern("frame_id")
+        tag.value= pmt.from_uint64(frame_id)
+
+        return tag
+
+    def test_001_equalize (self):
+        rnd= np.random.RandomState(0)
+
+        num_carriers= 24
+        fft_len= 32
+        num_symbols= 5
+
+        for (contiguous, pilots) in ((False, []), (True, [10, 22])):
+            data= [
+                rnd.choice([-1, 1], num_carriers * num_symbols)
+                + 1j * rnd.choice([-1, 1], num_carriers * num_symbols)
+                for frame in range(2)
+            ]
+
+            # Every frame sees a different channel, symbols
+            # outside of a frame have to be dropped
+            received= [rnd.normal(0, 1, (3, fft_len)).astype(complex)]
+
+            for frame in data:
+                symbols= self.transmit(frame, num_carriers, fft_len, contiguous, pilots)
+                channel= rnd.uniform(0.2, 2, fft_len) * np.exp(1j * rnd.uniform(-np.pi, np.pi, fft_len))
+
+                received.append(symbols * channel)
+
+            tags= [
+                self.frame_tag(3, 1),
+                self.frame_tag(3 + num_symbols + 2, 2)
+            ]
+
+            self.tb= gr.top_block()
+
+            src= blocks.vector_source_c(np.concatenate(received).flatten(), False, fft_len, tags)
+            extractor= hnez_ofdm.ho_extract_carriers(num_carriers, fft_len, contiguous, pilots)
+            dst= blocks.vector_sink_c(num_carriers)
+
+            self.tb.connect(src, extractor, dst)
+            self.tb.run()
+
+            self.assertComplexTuplesAlmostEqual(dst.data(), np.concatenate(data), 4)
+
+            # The frame tags are moved to the first payload symbol
+            offsets= [
+                (t.offset, pmt.to_uint64(t.value)) for t in dst.tags()
+                if pmt.symbol_to_string(t.key) == "frame_id"
+            ]
+
+            self.assertEqual(offsets, [(0, 1), (num_symbols, 2)])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_extract_carriers, "qa_ho_extract_carriers.xml")
@@ -0,0 +1,109 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import pmt
+
+import numpy as np
+
+
+class qa_ho_hamming74_packed (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def run_packets(self, packets, blocks_chain):
+        data= sum((list(p) for p in packets), [])
+        tags= list()
+
+        offset= 0
+        for p in packets:
+            tag= gr.tag_t()
+            tag.offset= offset
+            tag.key= pmt.intern("packet_len")
+            tag.value= pmt.from_long(len(p))
+
+            tags.append(tag)
+            offset+= len(p)
+
+        tb= gr.top_block()
+
+        src= blocks.vector_source_b(data, False, 1, tags)
+        dst= blocks.vector_sink_b()
+
+        tb.connect(src, *(blocks_chain + [dst]))
+        tb.run()
+
+        return dst.data()
+
+    def reference_chain(self, encode):
+        if encode:
+            return [
+                blocks.repack_bits_bb(8, 4, "packet_len", False, gr.GR_LSB_FIRST),
+                hnez_ofdm.ho_hamming74(True, "packet_len"),
+                blocks.repack_bits_bb(7, 8, "packet_len", False, gr.GR_LSB_FIRST)
+            ]
+        else:
+            return [
+                blocks.repack_bits_bb(8, 7, "packet_len", False, gr.GR_LSB_FIRST),
+                hnez_ofdm.ho_hamming74(False, "packet_len"),
+                blocks.repack_bits_bb(4, 8, "packet_len", False, gr.GR_LSB_FIRST)
+            ]
+
+    def test_001_same_as_repack_chain (self):
+        rnd= np.random.RandomState(0)
+
+        # Packet lengths that hit every tail length of
+        # the four byte (encode) and seven byte (decode) groups
+        packets= list(
+            tuple(rnd.randint(0, 256, length))
+            for length in list(range(1, 30)) + [1500]
+        )
+
+        for encode in (True, False):
+            expected= self.run_packets(packets, self.reference_chain(encode))
+            actual= self.run_packets(
+                packets, [hnez_ofdm.ho_hamming74_packed(encode, "packet_len")]
+            )
+
+            self.assertSequenceEqual(expected, actual)
+
+    def test_002_roundtrip (self):
+        data= (1, 2, 3, 4, 5, 6, 7, 8, 0xaa, 0x55, 0xff)
+
+        result= self.run_packets(
+            [data],
+            [
+                hnez_ofdm.ho_hamming74_packed(True, "packet_len"),
+                hnez_ofdm.ho_hamming74_packed(False, "packet_len")
+            ]
+        )
+
+        self.assertSequenceEqual(data, result[:len(data)])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_hamming74_packed, "qa_ho_hamming74_packed.xml")
@@ -0,0 +1,79 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import numpy as np
+
+
+class qa_ho_hamming74_soft (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def encode(self, data):
+        tb= gr.top_block()
+
+        src= blocks.vector_source_b(data, False, 1, [])
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_char, 1, len(data), "packet_len"
+        )
+        encoder= hnez_ofdm.ho_hamming74_packed(True, "packet_len")
+        dst= blocks.vector_sink_b()
+
+        tb.connect(src, tagger, encoder, dst)
+        tb.run()
+
+        return dst.data()
+
+    def test_001_t (self):
+        rnd= np.random.RandomState(0)
+
+        data= tuple(rnd.randint(0, 256, 28))
+        coded= np.array(self.encode(data), dtype=np.uint8)
+
+        # LSB first, a zero bit becomes a positive LLR
+        bits= np.unpackbits(coded[:, np.newaxis], axis=1)[:, ::-1].flatten()
+        llrs= (1.0 - 2.0 * bits) * rnd.uniform(0.5, 2.0, len(bits))
+
+        # Flip one weak bit in every codeword, the decoder has to correct them
+        for word in range(len(llrs) // 7):
+            llrs[word * 7 + rnd.randint(7)]*= -0.1
+
+        src= blocks.vector_source_f(tuple(llrs), False, 1, [])
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_float, 1, len(llrs), "packet_len"
+        )
+        decoder= hnez_ofdm.ho_hamming74_soft("packet_len")
+        dst= blocks.vector_sink_b()
+
+        self.tb.connect(src, tagger, decoder, dst)
+        self.tb.run ()
+
+        self.assertSequenceEqual(data, dst.data()[:len(data)])
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_hamming74_soft, "qa_ho_hamming74_soft.xml")
@@ -0,0 +1,101 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import numpy as np
+
+
+class qa_ho_ifft_cyclicprefix (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def modulate(self, symbols, fft_len, cp_len, fft_shift, window_len):
+        tb= gr.top_block()
+
+        src= blocks.vector_source_c(symbols.flatten(), False, fft_len, [])
+        modulator= hnez_ofdm.ho_ifft_cyclicprefix(fft_len, cp_len, fft_shift, window_len)
+        dst= blocks.vector_sink_c(fft_len + cp_len)
+
+        tb.connect(src, modulator, dst)
+        tb.run()
+
+        return np.array(dst.data()).reshape((-1, fft_len + cp_len))
+
+    def test_001_ifft_cp (self):
+        rnd= np.random.RandomState(0)
+
+        for fft_len in (64, 45):
+            cp_len= 8
+
+            symbols= rnd.normal(size=(4, fft_len)) + 1j * rnd.normal(size=(4, fft_len))
+
+            for fft_shift in (True, False):
+                spectrum= np.fft.ifftshift(symbols, 1) if fft_shift else symbols
+
+                # The transform is not scaled
+                body= np.fft.ifft(spectrum, axis=1) * fft_len
+                expected= np.concatenate((body[:, -cp_len:], body), 1)
+
+                output= self.modulate(symbols, fft_len, cp_len, fft_shift, 0)
+
+                self.assertComplexTuplesAlmostEqual(
+                    output.flatten(), expected.flatten(), 3
+                )
+
+    def test_002_window (self):
+        rnd= np.random.RandomState(1)
+
+        fft_len= 64
+        cp_len= 16
+        window_len= 6
+
+        symbols= rnd.normal(size=(3, fft_len)) + 1j * rnd.normal(size=(3, fft_len))
+
+        plain= self.modulate(symbols, fft_len, cp_len, True, 0)
+        windowed= self.modulate(symbols, fft_len, cp_len, True, window_len)
+
+        ramp= 0.5 - 0.5 * np.cos(np.pi * (np.arange(window_len) + 0.5) / window_len)
+
+        # The start of every prefix fades in while the previous
+        # symbol fades out, everything else is untouched
+        tails= np.concatenate((
+            np.zeros((1, window_len)),
+            plain[:-1, cp_len:cp_len + window_len] * (1 - ramp)
+        ))
+
+        expected= plain.copy()
+        expected[:, :window_len]= plain[:, :window_len] * ramp + tails
+
+        self.assertComplexTuplesAlmostEqual(
+            windowed.flatten(), expected.flatten(), 3
+        )
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_ifft_cyclicprefix, "qa_ho_ifft_cyclicprefix.xml")
@@ -55,5 +55,35 @@ class qa_ho_interleave (gr_unittest.TestCase):
             actual_result[:len(data)]
         )
 
+    def test_002_fixed_map (self):
+        # The permutation is derived from an LFSR and has to stay
+        # the same for receivers to understand older transmitters.
+        # The expected bytes were generated with the original
+        # bit by bit implementation of ho_interleave.
+        data= tuple((i * 37 + 11) % 256 for i in range(37))
+
+        expected= (
+            144, 27, 87, 105, 240, 12, 214, 50, 136, 184, 187, 244, 132, 145,
+            97, 230, 208, 158, 50, 171, 30, 231, 165, 223, 177, 148, 88,
+            36, 36, 12, 144, 48, 193, 32, 8, 4, 224, 128, 64, 120, 161,
+            32, 18, 0, 17, 4, 145, 4, 1, 128, 0, 2, 8, 0
+        )
+
+        data_src= blocks.vector_source_b(data, False, 1, [])
+        stream_tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_char, 1, len(data), "packet_len"
+        )
+        dst= blocks.vector_sink_b()
+
+        encoder= hnez_ofdm.ho_interleave(27, True, 'packet_len')
+
+        self.tb.connect((data_src, 0), (stream_tagger, 0))
+        self.tb.connect((stream_tagger, 0), (encoder, 0))
+        self.tb.connect((encoder, 0), (dst, 0))
+
+        self.tb.run ()
+
+        self.assertSequenceEqual(expected, dst.data())
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ho_interleave, "qa_ho_interleave.xml")
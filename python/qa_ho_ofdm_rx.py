@@ -0,0 +1,173 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import pmt
+
+import numpy as np
+
+
+class qa_ho_ofdm_rx (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def transmit(self, packet, fft_len, cp_len, num_carriers):
+        tb= gr.top_block()
+
+        tag= gr.tag_t()
+        tag.offset= 0
+        tag.key= pmt.intern("packet_len")
+        tag.value= pmt.from_long(len(packet))
+
+        src= blocks.vector_source_b(packet, False, 1, [tag])
+        tx= hnez_ofdm.ho_ofdm_tx(fft_len, cp_len, num_carriers)
+        dst= blocks.vector_sink_c(fft_len + cp_len)
+
+        tb.connect(src, tx, dst)
+        tb.run()
+
+        # Strip the cyclic prefixes, like the gate would
+        symbols= np.array(dst.data()).reshape(-1, fft_len + cp_len)
+
+        return symbols[:, cp_len:]
+
+    def test_001_loopback (self):
+        fft_len= 64
+        cp_len= 8
+        num_carriers= 48
+
+        packets= [
+            tuple((i * 37 + n) % 256 for i in range(n))
+            for n in (1, 26, 100, 500)
+        ]
+
+        # A flat channel with some attenuation and phase shift
+        channel= 0.3 * np.exp(1.1j)
+
+        signal= list()
+        tags= list()
+        num_symbols= list()
+
+        for (frame_id, packet) in enumerate(packets, 1):
+            symbols= self.transmit(packet, fft_len, cp_len, num_carriers) * channel
+
+            tag= gr.tag_t()
+            tag.offset= len(signal)
+            tag.key= pmt.intern("frame_id")
+            tag.value= pmt.from_uint64(frame_id)
+            tags.append(tag)
+
+            num_symbols.append(len(symbols))
+
+            # Some garbage the gate outputs before it sees the ack
+            signal.extend(symbols)
+            signal.extend(np.ones((2, fft_len)) * (1 + 2j))
+
+        src= blocks.vector_source_c(np.concatenate(signal), False, fft_len, tags)
+        rx= hnez_ofdm.ho_ofdm_rx(fft_len, num_carriers)
+        pdus= blocks.message_debug()
+        acks= blocks.message_debug()
+
+        self.tb.connect(src, rx)
+        self.tb.msg_connect(rx, "pdus", pdus, "store")
+        self.tb.msg_connect(rx, "frame_ack", acks, "store")
+        self.tb.run()
+
+        self.assertEqual(pdus.num_messages(), len(packets))
+        self.assertEqual(acks.num_messages(), len(packets))
+
+        for (idx, packet) in enumerate(packets):
+            pdu= pdus.get_message(idx)
+            meta= pmt.car(pdu)
+            payload= pmt.u8vector_elements(pmt.cdr(pdu))
+
+            self.assertEqual(tuple(payload), packet)
+            self.assertEqual(pmt.to_uint64(pmt.dict_ref(meta, pmt.intern("frame_id"),
+                                                        pmt.PMT_NIL)),
+                             idx + 1)
+
+            ack= acks.get_message(idx)
+
+            self.assertEqual(pmt.to_uint64(pmt.car(ack)), idx + 1)
+            self.assertEqual(pmt.to_long(pmt.cdr(ack)), num_symbols[idx])
+
+    def test_002_invalid (self):
+        self.assertRaises(ValueError, hnez_ofdm.ho_ofdm_rx, 64, 42)
+
+    def test_003_raw_pdus (self):
+        fft_len= 64
+        cp_len= 8
+        num_carriers= 48
+
+        packet= tuple((i * 37) % 256 for i in range(100))
+        symbols= self.transmit(packet, fft_len, cp_len, num_carriers)
+
+        # Flip all bits of one symbol behind the header
+        # in the second frame, its CRC check fails
+        corrupted= symbols.copy()
+        corrupted[6]*= -1
+
+        tags= list()
+
+        for frame_id in (1, 2):
+            tag= gr.tag_t()
+            tag.offset= (frame_id - 1) * len(symbols)
+            tag.key= pmt.intern("frame_id")
+            tag.value= pmt.from_uint64(frame_id)
+            tags.append(tag)
+
+        signal= np.concatenate((symbols, corrupted))
+
+        src= blocks.vector_source_c(signal.flatten(), False, fft_len, tags)
+        rx= hnez_ofdm.ho_ofdm_rx(fft_len, num_carriers, False, [], 4096, True)
+        pdus= blocks.message_debug()
+        raw_pdus= blocks.message_debug()
+
+        self.tb.connect(src, rx)
+        self.tb.msg_connect(rx, "pdus", pdus, "store")
+        self.tb.msg_connect(rx, "raw_pdus", raw_pdus, "store")
+        self.tb.run()
+
+        self.assertEqual(pdus.num_messages(), 1)
+        self.assertEqual(raw_pdus.num_messages(), 2)
+
+        for (idx, crc_ok) in enumerate((True, False)):
+            pdu= raw_pdus.get_message(idx)
+            meta= pmt.car(pdu)
+            payload= tuple(pmt.u8vector_elements(pmt.cdr(pdu)))
+
+            self.assertEqual(pmt.to_bool(pmt.dict_ref(meta, pmt.intern("crc_ok"),
+                                                      pmt.PMT_NIL)),
+                             crc_ok)
+            self.assertEqual(len(payload), len(packet))
+            self.assertEqual(payload == packet, crc_ok)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_ofdm_rx, "qa_ho_ofdm_rx.xml")
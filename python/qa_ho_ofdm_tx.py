@@ -0,0 +1,110 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+from gnuradio import fft
+import hnez_ofdm_swig as hnez_ofdm
+
+import pmt
+
+import numpy as np
+
+
+class qa_ho_ofdm_tx (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def transmit(self, blocks_chain, packets, vlen):
+        tb= gr.top_block()
+
+        data= tuple(b for packet in packets for b in packet)
+        tags= []
+        offset= 0
+
+        for packet in packets:
+            tag= gr.tag_t()
+            tag.offset= offset
+            tag.key= pmt.intern("packet_len")
+            tag.value= pmt.from_long(len(packet))
+            tags.append(tag)
+
+            offset+= len(packet)
+
+        src= blocks.vector_source_b(data, False, 1, tags)
+        dst= blocks.vector_sink_c(vlen)
+
+        tb.connect(src, *blocks_chain)
+        tb.connect(blocks_chain[-1], dst)
+        tb.run()
+
+        return np.array(dst.data())
+
+    def test_001_same_as_chain (self):
+        fft_len= 128
+        cp_len= 10
+        num_carriers= 108
+
+        packets= [
+            tuple((i * 37 + n) % 256 for i in range(n))
+            for n in (1, 26, 27, 100, 1500)
+        ]
+
+        for window_len in (0, 4):
+            chain= [
+                hnez_ofdm.ho_add_header("packet_len"),
+                hnez_ofdm.ho_hamming74_packed(True),
+                hnez_ofdm.ho_interleave(num_carriers // 4, True),
+                hnez_ofdm.ho_qam4_multimod(num_carriers),
+                hnez_ofdm.ho_assign_carriers(num_carriers, fft_len),
+                hnez_ofdm.ho_add_schmidlcox(fft_len)
+            ]
+
+            if window_len == 0:
+                # The chain of examples/ofdm_enc.grc
+                chain+= [
+                    fft.fft_vcc(fft_len, False, (), True),
+                    hnez_ofdm.ho_add_cyclicprefix(fft_len, cp_len)
+                ]
+            else:
+                # The stock blocks do not window the symbols
+                chain+= [
+                    hnez_ofdm.ho_ifft_cyclicprefix(fft_len, cp_len, True, window_len)
+                ]
+
+            fused= [
+                hnez_ofdm.ho_ofdm_tx(fft_len, cp_len, num_carriers,
+                                     False, 1, [], [], window_len)
+            ]
+
+            expected= self.transmit(chain, packets, fft_len + cp_len)
+            actual= self.transmit(fused, packets, fft_len + cp_len)
+
+            self.assertEqual(len(actual), len(expected))
+            self.assertComplexTuplesAlmostEqual(actual, expected, 4)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_ofdm_tx, "qa_ho_ofdm_tx.xml")
@@ -23,6 +23,8 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import hnez_ofdm_swig as hnez_ofdm
 
+import pmt
+
 class qa_ho_qam4_multimod (gr_unittest.TestCase):
 
     def setUp (self):
@@ -34,11 +36,15 @@ class qa_ho_qam4_multimod (gr_unittest.TestCase):
     def test_001_t (self):
         data= tuple(i for i in range(10))
         data_src= blocks.vector_source_b(data, False, 1, [])
+        stream_tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_char, 1, len(data), "packet_len"
+        )
         dst= blocks.vector_sink_c(40)
 
         modulator= hnez_ofdm.ho_qam4_multimod(40)
 
-        self.tb.connect((data_src, 0), (modulator, 0))
+        self.tb.connect((data_src, 0), (stream_tagger, 0))
+        self.tb.connect((stream_tagger, 0), (modulator, 0))
         self.tb.connect((modulator, 0), (dst, 0))
 
         self.tb.run ()
@@ -53,5 +59,44 @@ class qa_ho_qam4_multimod (gr_unittest.TestCase):
             6
         )
 
+    def make_tag(self, offset, key, value):
+        tag= gr.tag_t()
+        tag.offset= offset
+        tag.key= pmt.intern(key)
+        tag.value= pmt.from_long(value)
+
+        return tag
+
+    def test_002_tags (self):
+        data= tuple(i for i in range(50))
+        tags= [
+            self.make_tag(0, "packet_len", 20),
+            self.make_tag(15, "other", 1),
+            self.make_tag(20, "packet_len", 30)
+        ]
+
+        data_src= blocks.vector_source_b(data, False, 1, tags)
+        dst= blocks.vector_sink_c(40)
+
+        modulator= hnez_ofdm.ho_qam4_multimod(40)
+
+        self.tb.connect((data_src, 0), (modulator, 0))
+        self.tb.connect((modulator, 0), (dst, 0))
+
+        self.tb.run ()
+
+        self.assertEqual(len(dst.data()), 5 * 40)
+
+        out_tags= sorted(
+            (tag.offset, pmt.symbol_to_string(tag.key), pmt.to_long(tag.value))
+            for tag in dst.tags()
+        )
+
+        # Ten bytes make up one output vector
+        self.assertSequenceEqual(
+            out_tags,
+            [(0, "packet_len", 2), (1, "other", 1), (2, "packet_len", 3)]
+        )
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ho_qam4_multimod, "qa_ho_qam4_multimod.xml")
@@ -0,0 +1,75 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import numpy as np
+
+
+class qa_ho_qam4_soft_demod (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_t (self):
+        data= tuple(i * 37 % 256 for i in range(20))
+
+        src= blocks.vector_source_b(data, False, 1, [])
+        byte_tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_char, 1, len(data), "packet_len"
+        )
+        modulator= hnez_ofdm.ho_qam4_multimod(40)
+        to_stream= blocks.vector_to_stream(gr.sizeof_gr_complex, 40)
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_gr_complex, 1, len(data) * 4, "packet_len"
+        )
+        demod= hnez_ofdm.ho_qam4_soft_demod(1.0, "packet_len")
+        dst= blocks.vector_sink_f()
+
+        self.tb.connect(src, byte_tagger, modulator, to_stream, tagger, demod, dst)
+        self.tb.run ()
+
+        llrs= np.array(dst.data())
+
+        self.assertEqual(len(llrs), len(data) * 8)
+
+        # Output k is the LLR of bit k%8 of byte k/8,
+        # negative values stand for ones
+        bits= (llrs < 0).reshape((-1, 8))
+        received= tuple(
+            int(sum(int(b) << i for (i, b) in enumerate(byte_bits)))
+            for byte_bits in bits
+        )
+
+        self.assertSequenceEqual(data, received)
+
+        # Noise free symbols all have the same confidence
+        self.assertFloatTuplesAlmostEqual(
+            tuple(abs(llrs)), tuple(2.0 for l in llrs), 5
+        )
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_qam4_soft_demod, "qa_ho_qam4_soft_demod.xml")
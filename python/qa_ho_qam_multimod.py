@@ -0,0 +1,90 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import numpy as np
+
+
+class qa_ho_qam_multimod (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def modulate(self, modulator, data, output_width):
+        tb= gr.top_block()
+
+        src= blocks.vector_source_b(data, False, 1, [])
+        tagger= blocks.stream_to_tagged_stream(
+            gr.sizeof_char, 1, len(data), "packet_len"
+        )
+        dst= blocks.vector_sink_c(output_width)
+
+        tb.connect(src, tagger, modulator, dst)
+        tb.run()
+
+        return np.array(dst.data())
+
+    def test_001_qpsk_like_qam4 (self):
+        data= tuple(i * 37 % 256 for i in range(30))
+
+        expected= self.modulate(hnez_ofdm.ho_qam4_multimod(40), data, 40)
+        actual= self.modulate(hnez_ofdm.ho_qam_multimod(2, 40), data, 40)
+
+        self.assertComplexTuplesAlmostEqual(expected, actual, 6)
+
+    def test_002_gray_mapping (self):
+        data= tuple(range(256)) * 3
+
+        for bits_per_symbol in (4, 6, 8):
+            modulator= hnez_ofdm.ho_qam_multimod(bits_per_symbol, 16)
+            symbols= self.modulate(modulator, data, 16)
+
+            # All constellation points are used and
+            # the constellation has an average power of one
+            points= np.unique(np.round(symbols, 5))
+
+            self.assertEqual(len(points), 2**bits_per_symbol)
+            self.assertAlmostEqual(np.mean(abs(points)**2), 1.0, 4)
+
+            levels= 2**(bits_per_symbol // 2)
+            step= 2.0 / np.sqrt(2.0 * (levels**2 - 1) / 3.0)
+
+            # Split the input into symbol values, MSB first
+            bits= np.unpackbits(np.array(data, dtype=np.uint8))
+            values= bits[:len(symbols) * bits_per_symbol].reshape((-1, bits_per_symbol))
+            values= values.dot(1 << np.arange(bits_per_symbol)[::-1])
+
+            # Neighbouring constellation points differ in a single bit
+            point_values= dict(zip(np.round(symbols, 5), values))
+
+            for (pa, va) in point_values.items():
+                for (pb, vb) in point_values.items():
+                    if abs(abs(pa - pb) - step) < 1e-4:
+                        self.assertEqual(bin(va ^ vb).count('1'), 1)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_qam_multimod, "qa_ho_qam_multimod.xml")
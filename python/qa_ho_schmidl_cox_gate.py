@@ -25,7 +25,50 @@ from gnuradio import gr, gr_unittest
 from gnuradio import blocks
 import hnez_ofdm_swig as hnez_ofdm
 
+import pmt
+
 import numpy as np
+import time
+
+
+class ack_source(gr.sync_block):
+    '''Outputs a signal in two parts. Before the second part is
+    output it waits until the gate has output at least one symbol
+    and then sends the gate the pair frame_ack (frame_id . n)'''
+
+    def __init__(self, signal, split, gate, frame_ack):
+        gr.sync_block.__init__(self, 'ack_source', [], [np.complex64])
+
+        self.signal= np.array(signal, np.complex64)
+        self.split= split
+        self.gate= gate
+        self.frame_ack= frame_ack
+        self.pos= 0
+
+        self.message_port_register_out(pmt.intern('frame_ack'))
+
+    def work(self, input_items, output_items):
+        out= output_items[0]
+
+        if self.pos == self.split:
+            timeout= time.time() + 10
+
+            while self.gate.nitems_written(0) == 0 and time.time() < timeout:
+                time.sleep(0.001)
+
+            self.message_port_pub(pmt.intern('frame_ack'), self.frame_ack)
+            self.split= None
+
+        end= self.split if self.split is not None else len(self.signal)
+        num= min(len(out), end - self.pos)
+
+        if num <= 0:
+            return -1
+
+        out[:num]= self.signal[self.pos:self.pos + num]
+        self.pos+= num
+
+        return num
 
 
 class qa_ho_schmidl_cox_gate (gr_unittest.TestCase):
@@ -96,5 +139,423 @@ class qa_ho_schmidl_cox_gate (gr_unittest.TestCase):
 
         self.assertLess(symbol_d, 10e-6)
 
+    def test_002_block_metric (self):
+        rnd= np.random.RandomState(1)
+
+        fft_len= 128
+        cp_len= 10
+
+        ph_rot= 0.3 / fft_len
+
+        sent= self.random_complex(rnd, 0.5, 3000)
+
+        for frame_num in range(10):
+            preamble_halves= self.random_complex(rnd, 1, fft_len/2)
+            preamble= np.concatenate((preamble_halves, preamble_halves))
+
+            test_symbol= self.random_complex(rnd, 1, fft_len)
+
+            frame= np.concatenate((
+                preamble[-cp_len:], preamble, test_symbol[-cp_len:], test_symbol
+            ))
+
+            noise_during= self.random_complex(rnd, 0.01, len(frame))
+            noise_post= self.random_complex(rnd, 0.5, 3000)
+
+            sent= np.concatenate((sent, frame + noise_during, noise_post))
+
+        sent*= np.exp(1j * ph_rot * np.arange(len(sent)))
+
+        results= list()
+
+        for (block_metric, num_threads) in ((False, 1), (True, 1), (True, 4)):
+            tb= gr.top_block()
+
+            dat_src= blocks.vector_source_c(sent, False, 1, [])
+            gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8,
+                                                block_metric, num_threads)
+            dat_sink= blocks.vector_sink_c(fft_len)
+
+            tb.connect((dat_src, 0), (gate, 0))
+            tb.connect((gate, 0), (dat_sink, 0))
+
+            tb.run()
+
+            frame_starts= tuple(
+                tag.offset for tag in dat_sink.tags()
+                if pmt.symbol_to_string(tag.key) == 'frame_id'
+            )
+
+            results.append((frame_starts, dat_sink.data()))
+
+        scalar_starts, scalar_data= results[0]
+
+        self.assertEqual(len(scalar_starts), 10)
+
+        for (starts, data) in results[1:]:
+            # All variants have to find the same frames at the same positions
+            self.assertSequenceEqual(scalar_starts, starts)
+
+            # The outputs may only differ by float rounding
+            self.assertComplexTuplesAlmostEqual(scalar_data, data, 3)
+
+    def test_003_fft_out (self):
+        rnd= np.random.RandomState(2)
+
+        fft_len= 128
+        cp_len= 10
+
+        sent= self.random_complex(rnd, 0.5, 3000)
+
+        for frame_num in range(5):
+            preamble_halves= self.random_complex(rnd, 1, fft_len/2)
+            preamble= np.concatenate((preamble_halves, preamble_halves))
+
+            test_symbol= self.random_complex(rnd, 1, fft_len)
+
+            frame= np.concatenate((
+                preamble[-cp_len:], preamble, test_symbol[-cp_len:], test_symbol
+            ))
+
+            noise_during= self.random_complex(rnd, 0.01, len(frame))
+            noise_post= self.random_complex(rnd, 0.5, 3000)
+
+            sent= np.concatenate((sent, frame + noise_during, noise_post))
+
+        sent*= np.exp(1j * 0.2 / fft_len * np.arange(len(sent)))
+
+        results= list()
+
+        for (fft_out, fft_shift) in ((False, False), (True, False), (True, True)):
+            tb= gr.top_block()
+
+            dat_src= blocks.vector_source_c(sent, False, 1, [])
+            gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8,
+                                                True, 1, fft_out, fft_shift)
+            dat_sink= blocks.vector_sink_c(fft_len)
+
+            tb.connect((dat_src, 0), (gate, 0))
+            tb.connect((gate, 0), (dat_sink, 0))
+
+            tb.run()
+
+            results.append(np.array(dat_sink.data()).reshape((-1, fft_len)))
+
+        time_domain, freq_domain, freq_domain_shifted= results
+
+        self.assertGreater(len(time_domain), 0)
+
+        expected= np.fft.fft(time_domain, axis=1)
+
+        self.assertComplexTuplesAlmostEqual(
+            expected.flatten(), freq_domain.flatten(), 2
+        )
+
+        self.assertComplexTuplesAlmostEqual(
+            np.fft.fftshift(expected, axes=1).flatten(),
+            freq_domain_shifted.flatten(), 2
+        )
+
+    def test_004_max_frame_symbols (self):
+        rnd= np.random.RandomState(3)
+
+        fft_len= 128
+        cp_len= 10
+        num_frames= 5
+        max_frame_symbols= 3
+
+        sent= self.random_complex(rnd, 0.5, 3000)
+
+        for frame_num in range(num_frames):
+            preamble_halves= self.random_complex(rnd, 1, fft_len/2)
+            preamble= np.concatenate((preamble_halves, preamble_halves))
+
+            frame= np.concatenate((preamble[-cp_len:], preamble))
+
+            for sym_num in range(6):
+                symbol= self.random_complex(rnd, 1, fft_len)
+                frame= np.concatenate((frame, symbol[-cp_len:], symbol))
+
+            noise_during= self.random_complex(rnd, 0.01, len(frame))
+            noise_post= self.random_complex(rnd, 0.5, 3000)
+
+            sent= np.concatenate((sent, frame + noise_during, noise_post))
+
+        dat_src= blocks.vector_source_c(sent, False, 1, [])
+        gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8,
+                                            True, 1, False, True,
+                                            max_frame_symbols)
+        dat_sink= blocks.vector_sink_c(fft_len)
+
+        self.tb.connect((dat_src, 0), (gate, 0))
+        self.tb.connect((gate, 0), (dat_sink, 0))
+
+        self.tb.run()
+
+        frame_starts= tuple(
+            tag.offset for tag in dat_sink.tags()
+            if pmt.symbol_to_string(tag.key) == 'frame_id'
+        )
+
+        # Every frame is cut off after exactly max_frame_symbols
+        self.assertSequenceEqual(
+            frame_starts,
+            tuple(range(0, num_frames * max_frame_symbols, max_frame_symbols))
+        )
+
+        self.assertEqual(len(dat_sink.data()), num_frames * max_frame_symbols * fft_len)
+
+    def test_005_stats (self):
+        rnd= np.random.RandomState(4)
+
+        fft_len= 128
+        cp_len= 10
+        num_frames= 4
+
+        # A frequency offset of a quarter carrier spacing
+        ph_rot= 2 * np.pi * 0.25 / fft_len
+
+        sent= self.random_complex(rnd, 0.5, 3000)
+
+        for frame_num in range(num_frames):
+            preamble_halves= self.random_complex(rnd, 1, fft_len/2)
+            preamble= np.concatenate((preamble_halves, preamble_halves))
+
+            test_symbol= self.random_complex(rnd, 1, fft_len)
+
+            frame= np.concatenate((
+                preamble[-cp_len:], preamble, test_symbol[-cp_len:], test_symbol
+            ))
+
+            noise_during= self.random_complex(rnd, 0.01, len(frame))
+            noise_post= self.random_complex(rnd, 0.5, 3000)
+
+            sent= np.concatenate((sent, frame + noise_during, noise_post))
+
+        sent*= np.exp(1j * ph_rot * np.arange(len(sent)))
+
+        dat_src= blocks.vector_source_c(sent, False, 1, [])
+        gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8)
+        dat_sink= blocks.null_sink(gr.sizeof_gr_complex * fft_len)
+        stats_sink= blocks.message_debug()
+
+        gate.set_stats_interval(4096)
+
+        self.tb.connect((dat_src, 0), (gate, 0))
+        self.tb.connect((gate, 0), (dat_sink, 0))
+        self.tb.msg_connect(gate, "stats", stats_sink, "store")
+
+        self.tb.run()
+
+        stats= gate.get_stats()
+
+        def counter(name):
+            return pmt.to_uint64(pmt.dict_ref(stats, pmt.intern(name), pmt.PMT_NIL))
+
+        self.assertEqual(counter("preambles_detected"), num_frames)
+        self.assertEqual(counter("realign_failures"), 0)
+        self.assertEqual(counter("frames_aborted"), 0)
+        self.assertEqual(counter("frames_acked"), 0)
+        self.assertGreater(counter("samples_scanned"), len(sent) - 4 * (fft_len + cp_len))
+        self.assertLessEqual(counter("samples_scanned"), len(sent))
+
+        power_hist= pmt.u64vector_elements(
+            pmt.dict_ref(stats, pmt.intern("preamble_power_hist"), pmt.PMT_NIL)
+        )
+        cfo_hist= pmt.u64vector_elements(
+            pmt.dict_ref(stats, pmt.intern("cfo_hist"), pmt.PMT_NIL)
+        )
+
+        self.assertEqual(sum(power_hist), num_frames)
+
+        # Bins of 1/8 carrier spacing starting at -1
+        self.assertEqual(cfo_hist[10], num_frames)
+
+        self.assertGreater(stats_sink.num_messages(), 0)
+
+    def test_006_fine_timing (self):
+        rnd= np.random.RandomState(5)
+
+        fft_len= 128
+        cp_len= 16
+        num_carriers= 96
+        num_frames= 10
+
+        # Generate frames with the real preamble using the transmitter
+        tag= gr.tag_t()
+        tag.offset= 0
+        tag.key= pmt.intern("packet_len")
+        tag.value= pmt.from_long(20)
+
+        tx_tb= gr.top_block()
+        tx_src= blocks.vector_source_b(list(range(20)), False, 1, [tag])
+        tx= hnez_ofdm.ho_ofdm_tx(fft_len, cp_len, num_carriers)
+        tx_sink= blocks.vector_sink_c(fft_len + cp_len)
+
+        tx_tb.connect(tx_src, tx, tx_sink)
+        tx_tb.run()
+
+        frame= np.array(tx_sink.data()) / np.sqrt(num_carriers)
+
+        clean= np.zeros(3000, np.complex64)
+        preamble_starts= list()
+
+        for frame_num in range(num_frames):
+            preamble_starts.append(len(clean) + cp_len)
+            gap= np.zeros(2000 + rnd.randint(0, 300), np.complex64)
+
+            clean= np.concatenate((clean, frame, gap))
+
+        # A weaker second path, a frequency offset and some noise
+        sent= clean.copy()
+        sent[3:]+= 0.4 * clean[:-3]
+        sent*= np.exp(1j * 2 * np.pi * 0.3 / fft_len * np.arange(len(sent)))
+        sent+= self.random_complex(rnd, 0.03, len(sent))
+
+        dat_src= blocks.vector_source_c(sent, False, 1, [])
+        gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8,
+                                            True, 1, False, True,
+                                            1, True)
+        dat_sink= blocks.vector_sink_c(fft_len)
+
+        self.tb.connect((dat_src, 0), (gate, 0))
+        self.tb.connect((gate, 0), (dat_sink, 0))
+
+        self.tb.run()
+
+        received= np.array(dat_sink.data()).reshape((-1, fft_len))
+
+        self.assertEqual(len(received), num_frames)
+
+        offsets= range(-2 * cp_len, 2 * cp_len)
+
+        for (symbol, start) in zip(received, preamble_starts):
+            corr= [
+                abs(np.vdot(clean[start + off : start + off + fft_len], symbol))
+                for off in offsets
+            ]
+
+            # Every frame starts cp_len/8 samples before the preamble
+            self.assertEqual(offsets[np.argmax(corr)], -(cp_len // 8))
+
+        self.assertRaises(ValueError, hnez_ofdm.ho_schmidl_cox_gate,
+                          64, 32, 0.7, 0.8, True, 1, False, True, 0, True)
+
+    def test_007_integer_cfo (self):
+        rnd= np.random.RandomState(6)
+
+        fft_len= 128
+        cp_len= 16
+        num_carriers= 96
+        num_frames= 5
+
+        tag= gr.tag_t()
+        tag.offset= 0
+        tag.key= pmt.intern("packet_len")
+        tag.value= pmt.from_long(20)
+
+        tx_tb= gr.top_block()
+        tx_src= blocks.vector_source_b(list(range(20)), False, 1, [tag])
+        tx= hnez_ofdm.ho_ofdm_tx(fft_len, cp_len, num_carriers)
+        tx_sink= blocks.vector_sink_c(fft_len + cp_len)
+
+        tx_tb.connect(tx_src, tx, tx_sink)
+        tx_tb.run()
+
+        frame= np.array(tx_sink.data()) / np.sqrt(num_carriers)
+
+        clean= np.zeros(3000, np.complex64)
+
+        for frame_num in range(num_frames):
+            gap= np.zeros(2000 + rnd.randint(0, 300), np.complex64)
+            clean= np.concatenate((clean, frame, gap))
+
+        for cfo in (3.3, -5.7):
+            sent= clean * np.exp(1j * 2 * np.pi * cfo / fft_len * np.arange(len(clean)))
+            sent+= self.random_complex(rnd, 0.03, len(sent))
+
+            results= list()
+
+            for max_cfo_carriers in (0, 8):
+                tb= gr.top_block()
+
+                dat_src= blocks.vector_source_c(sent, False, 1, [])
+                gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8,
+                                                    True, 1, False, True,
+                                                    2, False, max_cfo_carriers)
+                dat_sink= blocks.vector_sink_c(fft_len)
+
+                tb.connect((dat_src, 0), (gate, 0))
+                tb.connect((gate, 0), (dat_sink, 0))
+
+                tb.run()
+
+                results.append(tuple(
+                    -pmt.to_double(tag.value) * fft_len / (2 * np.pi)
+                    for tag in dat_sink.tags()
+                    if pmt.symbol_to_string(tag.key) == 'fq_compensation'
+                ))
+
+            (ambiguous, resolved)= results
+
+            self.assertEqual(len(resolved), num_frames)
+
+            for estimate in ambiguous:
+                # Without the second preamble the offset wraps around
+                self.assertAlmostEqual(estimate - cfo, 2 * round((estimate - cfo) / 2), 1)
+                self.assertLessEqual(abs(estimate), 1)
+
+            for estimate in resolved:
+                self.assertAlmostEqual(estimate, cfo, 1)
+
+        self.assertRaises(ValueError, hnez_ofdm.ho_schmidl_cox_gate,
+                          64, 8, 0.7, 0.8, True, 1, False, True, 0, False, 32)
+
+    def test_008_pair_ack (self):
+        rnd= np.random.RandomState(7)
+
+        fft_len= 128
+        cp_len= 10
+        frame_len= 6
+
+        preamble_halves= self.random_complex(rnd, 1, fft_len/2)
+        preamble= np.concatenate((preamble_halves, preamble_halves))
+
+        frame= np.concatenate((preamble[-cp_len:], preamble))
+
+        for sym_num in range(9):
+            symbol= self.random_complex(rnd, 1, fft_len)
+            frame= np.concatenate((frame, symbol[-cp_len:], symbol))
+
+        noise_pre= self.random_complex(rnd, 0.5, 3000)
+        noise_during= self.random_complex(rnd, 0.01, len(frame))
+        noise_post= self.random_complex(rnd, 0.5, 3000)
+
+        sent= np.concatenate((noise_pre, frame + noise_during, noise_post))
+
+        # The ack arrives after the preamble and at most three
+        # more symbols were output, the frame has to end after
+        # frame_len symbols counted from the preamble
+        split= len(noise_pre) + 4 * (fft_len + cp_len)
+
+        gate= hnez_ofdm.ho_schmidl_cox_gate(fft_len, cp_len, 0.7, 0.8)
+        dat_src= ack_source(sent, split, gate,
+                            pmt.cons(pmt.from_uint64(1), pmt.from_uint64(frame_len)))
+        dat_sink= blocks.vector_sink_c(fft_len)
+
+        self.tb.connect((dat_src, 0), (gate, 0))
+        self.tb.connect((gate, 0), (dat_sink, 0))
+        self.tb.msg_connect(dat_src, "frame_ack", gate, "frame_ack")
+
+        self.tb.run()
+
+        frame_starts= tuple(
+            tag.offset for tag in dat_sink.tags()
+            if pmt.symbol_to_string(tag.key) == 'frame_id'
+        )
+
+        self.assertSequenceEqual(frame_starts, (0, ))
+        self.assertEqual(len(dat_sink.data()), frame_len * fft_len)
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ho_schmidl_cox_gate, "qa_ho_schmidl_cox_gate.xml")
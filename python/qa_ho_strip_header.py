@@ -0,0 +1,97 @@
+#!/usr/bin/env python2
+# -*- coding: utf-8 -*-
+#
+# Copyright 2017 Leonard Göhrs <leonard@goehrs.eu>.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import hnez_ofdm_swig as hnez_ofdm
+
+import pmt
+
+
+class qa_ho_strip_header (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def tagged_source(self, packets):
+        data= tuple(b for packet in packets for b in packet)
+        tags= []
+        offset= 0
+
+        for packet in packets:
+            tag= gr.tag_t()
+            tag.offset= offset
+            tag.key= pmt.intern("packet_len")
+            tag.value= pmt.from_long(len(packet))
+            tags.append(tag)
+
+            offset+= len(packet)
+
+        return blocks.vector_source_b(data, False, 1, tags)
+
+    def test_001_drop_bad (self):
+        data= (1, 2, 3, 4, 5, 6, 7, 8)
+        header= (0, 0, 0, 8, 235, 244, 114, 39)
+
+        packets= (
+            header + data,
+            header + (1, 2, 3, 4, 5, 6, 7, 9),  # Bad CRC
+            (0, 0, 0, 9) + header[4:] + data,   # Bad length
+            header + data + (0, 0, 0),          # Padded
+            (1, 2, 3),                          # Too short
+            header + data
+        )
+
+        src= self.tagged_source(packets)
+        header_stripper= hnez_ofdm.ho_strip_header("packet_len")
+        dst= blocks.vector_sink_b()
+
+        self.tb.connect(src, header_stripper, dst)
+        self.tb.run ()
+
+        self.assertSequenceEqual(dst.data(), data + data + data)
+
+    def test_002_roundtrip (self):
+        packets= tuple(
+            tuple((i * 37 + n) % 256 for i in range(n))
+            for n in (1, 15, 16, 63, 64, 65, 200, 1500)
+        )
+
+        src= self.tagged_source(packets)
+        header_adder= hnez_ofdm.ho_add_header("packet_len")
+        header_stripper= hnez_ofdm.ho_strip_header("packet_len")
+        dst= blocks.vector_sink_b()
+
+        self.tb.connect(src, header_adder, header_stripper, dst)
+        self.tb.run ()
+
+        self.assertSequenceEqual(
+            dst.data(),
+            tuple(b for packet in packets for b in packet)
+        )
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ho_strip_header, "qa_ho_strip_header.xml")
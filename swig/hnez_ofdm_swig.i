@@ -9,20 +9,35 @@
 
 %{
 #include "hnez_ofdm/ho_add_header.h"
+#include "hnez_ofdm/ho_strip_header.h"
 #include "hnez_ofdm/ho_hamming74.h"
+#include "hnez_ofdm/ho_hamming74_packed.h"
+#include "hnez_ofdm/ho_hamming74_soft.h"
 #include "hnez_ofdm/ho_interleave.h"
 #include "hnez_ofdm/ho_qam4_multimod.h"
+#include "hnez_ofdm/ho_qam4_soft_demod.h"
+#include "hnez_ofdm/ho_qam_multimod.h"
 #include "hnez_ofdm/ho_assign_carriers.h"
 #include "hnez_ofdm/ho_add_schmidlcox.h"
 #include "hnez_ofdm/ho_add_cyclicprefix.h"
+#include "hnez_ofdm/ho_ifft_cyclicprefix.h"
+#include "hnez_ofdm/ho_ofdm_tx.h"
+#include "hnez_ofdm/ho_ofdm_rx.h"
 #include "hnez_ofdm/ho_schmidl_cox_gate.h"
+#include "hnez_ofdm/ho_extract_carriers.h"
 %}
 
 
 %include "hnez_ofdm/ho_add_header.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_add_header);
+%include "hnez_ofdm/ho_strip_header.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_strip_header);
 %include "hnez_ofdm/ho_hamming74.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_hamming74);
+%include "hnez_ofdm/ho_hamming74_packed.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_hamming74_packed);
+%include "hnez_ofdm/ho_hamming74_soft.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_hamming74_soft);
 %include "hnez_ofdm/ho_interleave.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_interleave);
 %include "hnez_ofdm/ho_assign_carriers.h"
@@ -30,11 +45,23 @@ GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_assign_carriers);
 
 %include "hnez_ofdm/ho_qam4_multimod.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_qam4_multimod);
+%include "hnez_ofdm/ho_qam4_soft_demod.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_qam4_soft_demod);
+%include "hnez_ofdm/ho_qam_multimod.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_qam_multimod);
 %include "hnez_ofdm/ho_add_schmidlcox.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_add_schmidlcox);
 %include "hnez_ofdm/ho_add_cyclicprefix.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_add_cyclicprefix);
+%include "hnez_ofdm/ho_ifft_cyclicprefix.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_ifft_cyclicprefix);
+%include "hnez_ofdm/ho_ofdm_tx.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_ofdm_tx);
+%include "hnez_ofdm/ho_ofdm_rx.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_ofdm_rx);
 
 
 %include "hnez_ofdm/ho_schmidl_cox_gate.h"
 GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_schmidl_cox_gate);
+%include "hnez_ofdm/ho_extract_carriers.h"
+GR_SWIG_BLOCK_MAGIC2(hnez_ofdm, ho_extract_carriers);